@@ -141,22 +141,24 @@ public:
 
     Actor_speed speed() const;
 
-    virtual std::string name_the() const
+    //NOTE: The names are returned by reference to avoid copying them for every
+    //message - copy the name if the actor may be destroyed while it is used
+    virtual const std::string& name_the() const
     {
         return data_->name_the;
     }
 
-    virtual std::string name_a() const
+    virtual const std::string& name_a() const
     {
         return data_->name_a;
     }
 
-    std::string corpse_name_a() const
+    const std::string& corpse_name_a() const
     {
         return data_->corpse_name_a;
     }
 
-    std::string corpse_name_the() const
+    const std::string& corpse_name_the() const
     {
         return data_->corpse_name_the;
     }
@@ -169,8 +169,13 @@ namespace actor_data
 
 extern Actor_data_t data[(size_t)Actor_id::END];
 
+//Builds the data list (once, when the game starts)
 void init();
 
+//Restores the fields which change during a game (kill counts, spawn limits,
+//player name) to their initial values - the rest of the data list is kept
+void init_session();
+
 void save();
 void load();
 
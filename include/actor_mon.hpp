@@ -5,6 +5,7 @@
 #include "actor.hpp"
 #include "sound.hpp"
 #include "spells.hpp"
+#include "fov.hpp"
 
 struct Ai_att_data
 {
@@ -50,6 +51,11 @@ public:
     bool can_see_actor(const Actor& other,
                        const bool hard_blocked_los[MAP_W][MAP_H]) const;
 
+    //Stores line of sight to all other actors within FOV range, for use by
+    //can_see_actor(). This only reads the map and the actors (and writes to
+    //this monster), so it can be run for several monsters in parallel.
+    void prepare_los(const bool hard_blocked_los[MAP_W][MAP_H]) const;
+
     void act() override;
 
     void move(Dir dir);
@@ -122,6 +128,9 @@ protected:
     virtual void on_std_turn_hook() {}
 
     int group_size();
+
+private:
+    mutable Los_cache los_cache_;
 };
 
 class Rat: public Mon
@@ -923,9 +932,9 @@ public:
 
     ~Animated_wpn() {}
 
-    std::string name_the() const override;
+    const std::string& name_the() const override;
 
-    std::string name_a() const override;
+    const std::string& name_a() const override;
 
     char glyph() const override;
 
@@ -941,6 +950,9 @@ public:
 
 private:
     int nr_turns_until_drop_;
+
+    //The name depends on the wielded item, and is built when requested
+    mutable std::string name_the_, name_a_;
 };
 
 #endif
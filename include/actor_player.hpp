@@ -107,6 +107,9 @@ public:
     void on_log_msg_printed();  //Aborts e.g. searching and quick move
     void interrupt_actions();   //Aborts e.g. healing
 
+    //Resting, quick move or first aid
+    bool is_in_multi_turn_action() const;
+
     int enc_percent() const;
 
     int carry_weight_lmt() const;
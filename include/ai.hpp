@@ -5,6 +5,7 @@
 
 #include "cmn.hpp"
 
+class Actor;
 class Mon;
 
 namespace ai
@@ -44,6 +45,13 @@ void try_set_path_to_player(Mon& mon, std::vector<P>& path);
 
 void set_special_blocked_cells(Mon& mon, bool a[MAP_W][MAP_H]);
 
+//Move costs for the pathfinder. Blocked cells cannot be entered, and cells with
+//traps or fire cost more, so actors walk around them if there is a way (only
+//traps known by the moving actor are counted).
+void mk_move_costs(const Actor& mover,
+                   const bool blocked[MAP_W][MAP_H],
+                   int out[MAP_W][MAP_H]);
+
 } //info
 
 } //ai
@@ -57,7 +57,6 @@ public:
     P               aim_pos;
     int             hit_chance_tot;
     Actor_size      intended_aim_lvl, defender_size;
-    std::string     verb_player_attacks, verb_other_attacks;
 };
 
 class Throw_att_data: public Att_data
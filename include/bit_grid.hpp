@@ -0,0 +1,65 @@
+#ifndef BIT_GRID_HPP
+#define BIT_GRID_HPP
+
+#include <cstdint>
+
+#include "rl_utils.hpp"
+#include "cmn.hpp"
+
+//Map sized grid of booleans, packed as one 128 bit row per map line (bit x of
+//row y is the cell at x, y). Set operations, dilation and erosion work on a
+//whole row at a time using shifts, with SSE2 when available.
+//
+//It can be converted to and from the boolean map arrays used elsewhere.
+class Bit_grid
+{
+public:
+    struct alignas(16) Row
+    {
+        uint64_t lo; //x = 0  - 63
+        uint64_t hi; //x = 64 - 127
+    };
+
+    Bit_grid();
+
+    Bit_grid(const bool in[MAP_W][MAP_H]);
+
+    void from_array(const bool in[MAP_W][MAP_H]);
+
+    void to_array(bool out[MAP_W][MAP_H]) const;
+
+    void clear();
+
+    void set(const P& p, const bool VALUE = true);
+
+    bool at(const P& p) const;
+
+    bool is_empty() const;
+
+    Bit_grid& operator|=(const Bit_grid& other);
+
+    Bit_grid& operator&=(const Bit_grid& other);
+
+    //Unsets all cells which are set in the other grid
+    Bit_grid& subtract(const Bit_grid& other);
+
+    //Inverts all cells inside the map
+    void invert();
+
+    //Sets all cells within the Chebyshev distance of any set cell (cells
+    //outside the map are not considered)
+    Bit_grid dilated(const int DIST) const;
+
+    //Keeps only set cells which have no unset cell within the Chebyshev
+    //distance (cells outside the map are not considered)
+    Bit_grid eroded(const int DIST) const;
+
+    //Sets all cells which have any set cell at a Chebyshev distance within the
+    //given interval
+    Bit_grid dist_band(const Range& dist_interval) const;
+
+private:
+    Row rows_[MAP_H];
+};
+
+#endif
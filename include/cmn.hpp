@@ -49,7 +49,6 @@ const int MIN_DLVL_HARDER_TRAPS             = 6;
 
 const int AUDIO_ALLOCATED_CHANNELS          = 16;
 
-const size_t MS_DELAY_PLAYER_UNABLE_ACT     = 7;
 const size_t MIN_MS_BETWEEN_SAME_SFX        = 60;
 
 const int PLAYER_START_HP                   = 16;
@@ -13,6 +13,7 @@ void toggle_fullscreen();
 bool            is_tiles_mode();
 std::string     font_name();
 bool            is_fullscreen();
+bool            is_hw_map_drawing();
 int             scr_px_w();
 int             scr_px_h();
 int             cell_px_w();
@@ -24,32 +24,6 @@ public:
     }
 };
 
-class Smoke: public Mob
-{
-public:
-    Smoke(const P& feature_pos, const int NR_TURNS) :
-        Mob(feature_pos), nr_turns_left_(NR_TURNS) {}
-
-    //Spawn-by-id compliant ctor (do not use for normal cases):
-    Smoke(const P& feature_pos) : Mob(feature_pos), nr_turns_left_(-1) {}
-
-    Smoke() = delete;
-    ~Smoke() {}
-
-    Feature_id id() const override
-    {
-        return Feature_id::smoke;
-    }
-
-    std::string name(const Article article)  const override;
-    Clr clr() const override;
-
-    void on_new_turn() override;
-
-protected:
-    int nr_turns_left_;
-};
-
 class Lit_dynamite: public Mob
 {
 public:
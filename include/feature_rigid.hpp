@@ -76,9 +76,19 @@ public:
 
     void corrupt_color();
 
+    //Active rigids have something to do in on_new_turn() (e.g. burning), only
+    //these are run each turn (see map::activate_rigid())
+    bool is_active() const;
+
 protected:
     virtual void on_new_turn_hook() {}
 
+    //Should return true while on_new_turn_hook() has any work to do
+    virtual bool is_active_hook() const
+    {
+        return false;
+    }
+
     virtual void on_hit(const Dmg_type dmg_type,
                         const Dmg_method dmg_method,
                         Actor* const actor) = 0;
@@ -522,6 +532,8 @@ public:
     void on_new_turn_hook() override;
 
 private:
+    bool is_active_hook() const override;
+
     Clr clr_default() const override;
 
     void on_hit(const Dmg_type dmg_type, const Dmg_method dmg_method,
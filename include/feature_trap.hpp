@@ -117,6 +117,11 @@ public:
     void player_try_spot_hidden();
 
 private:
+    bool is_active_hook() const override
+    {
+        return nr_turns_until_trigger_ > 0;
+    }
+
     Trap_impl* mk_trap_impl_from_id(const Trap_id trap_id);
 
     Clr clr_default() const override;
@@ -29,6 +29,35 @@ void run(const P& p0,
          const bool hard_blocked[MAP_W][MAP_H],
          Los_result out[MAP_W][MAP_H]);
 
+//Must be called when anything blocking line of sight, or the light map, has
+//changed - this discards the results stored by all line of sight caches
+void on_los_changed();
+
 } //fov
 
+//Stores line of sight results from one origin to cells within FOV range, so
+//that repeated checks (e.g. a monster looking at all other actors each turn)
+//do not walk the same lines again. The results are discarded when the origin
+//moves, or when fov::on_los_changed() is called (e.g. when a door is opened,
+//or when the light map changes).
+//
+//NOTE: The hard blocked array passed in must describe the current map, since
+//it is only read when a result is not already stored.
+class Los_cache
+{
+public:
+    Los_cache();
+
+    Los_result check_cell(const P& p0,
+                          const P& p1,
+                          const bool hard_blocked[MAP_W][MAP_H]);
+
+private:
+    P               origin_;
+    unsigned int    generation_;
+
+    bool            is_stored_[FOV_STD_W_INT][FOV_STD_W_INT];
+    Los_result      results_[FOV_STD_W_INT][FOV_STD_W_INT];
+};
+
 #endif
@@ -0,0 +1,45 @@
+#ifndef GAS_HPP
+#define GAS_HPP
+
+#include <cstdint>
+
+#include "rl_utils.hpp"
+#include "cmn.hpp"
+
+enum class Gas_id
+{
+    smoke,
+    END
+};
+
+//Gases are stored as one dense field per gas type, holding the number of turns
+//left in each cell (zero means no gas), instead of as one mob per cell. The
+//fields are updated by a single pass over the map each turn, which is skipped
+//entirely while there is no gas on the map.
+namespace gas
+{
+
+//Removes all gas
+void reset();
+
+//Sets the number of turns left at the position, unless there is already more
+//gas there (i.e. adding gas to a cell never shortens its lifetime)
+//NOTE: Gas which blocks line of sight discards all stored line of sight results
+//when it appears in, or disappears from, a cell
+void add(const Gas_id id, const P& p, const int NR_TURNS);
+
+int nr_turns_left(const Gas_id id, const P& p);
+
+bool has_gas(const Gas_id id, const P& p);
+
+bool blocks_los(const P& p);
+
+bool is_any_gas();
+
+//Applies the gas effects on actors standing in gas, then counts down the gas
+//lifetimes
+void on_new_turn();
+
+} //gas
+
+#endif
@@ -5,6 +5,7 @@
 #include <string>
 
 #include "player_bon.hpp"
+#include "cmn.hpp"
 
 class Highscore_entry
 {
@@ -75,10 +76,24 @@ namespace highscore
 void init();
 void cleanup();
 
+//Imports the old highscore file into the run log, if the run log is empty
+//(called once at startup)
+void import_old_file();
+
 void run_highscore_screen();
 
+//Called when the player dies, to record what killed the player (the monster
+//acting at the time is recorded as the killer)
+void set_death_cause(const std::string& cause);
+void set_death_cause(const Dmg_type dmg_type);
+
+//Adds the run to the run log
 void on_game_over(const bool IS_WIN);
 
+//Adds the current bot run to the run log, and starts counting a new run
+void on_bot_run_done();
+
+//The best scoring runs, highest first (not including bot runs)
 std::vector<Highscore_entry> entries_sorted();
 
 const Highscore_entry* final_score();
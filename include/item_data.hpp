@@ -317,9 +317,14 @@ namespace item_data
 
 extern Item_data_t data[size_t(Item_id::END)];
 
+//Builds the data list (once, when the game starts)
 void init();
 void cleanup();
 
+//Restores the fields which change during a game (identification, spawning
+//allowed) to their initial values - the rest of the data list is kept
+void init_session();
+
 void save();
 void load();
 
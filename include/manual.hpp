@@ -7,8 +7,6 @@
 namespace manual
 {
 
-void init(); //{read_file();}
-
 void run();
 
 } //Manual
@@ -14,19 +14,70 @@
 class Rigid;
 class Mob;
 
+//The map is stored as one dense array ("plane") per cell field, so that loops
+//over the whole map which run every turn (e.g. updating the light map or the
+//player FOV) only need to read or write the fields they use. These loops can
+//work on the planes directly, other code can access a single cell through the
+//Cell view (map::cells[x][y]).
+struct Cell_planes
+{
+    bool                is_explored         [MAP_W][MAP_H];
+    bool                is_seen_by_player   [MAP_W][MAP_H];
+    //NOTE: Line of sight caches depend on the light and darkness. The light is
+    //only set by game_time::update_light_map() (which discards stored results
+    //if it changed), and both are only changed otherwise while building a map
+    //(after which all stored results are discarded).
+    bool                is_lit              [MAP_W][MAP_H];
+    bool                is_dark             [MAP_W][MAP_H];
+    Los_result          player_los          [MAP_W][MAP_H]; //Updated when player updates FOV
+    Item*               item                [MAP_W][MAP_H];
+    Rigid*              rigid               [MAP_W][MAP_H];
+    Feature_id          rigid_id            [MAP_W][MAP_H];
+    Cell_render_data    player_visual_memory[MAP_W][MAP_H];
+};
+
+//References to the fields of one map cell
 struct Cell
 {
-    Cell();
-    ~Cell();
+    Cell(const P& p);
 
     void reset();
 
-    bool                is_explored, is_seen_by_player, is_lit, is_dark;
-    Los_result          player_los; //Updated when player updates FOV
-    Item*               item;
-    Rigid*              rigid;
-    Cell_render_data    player_visual_memory;
-    P                   pos;
+    bool&               is_explored;
+    bool&               is_seen_by_player;
+    bool&               is_lit;
+    bool&               is_dark;
+    Los_result&         player_los;
+    Item*&              item;
+    Rigid* const&       rigid;      //Set with map::put()
+    const Feature_id&   rigid_id;   //Id of the rigid, for checks without virtual calls
+    Cell_render_data&   player_visual_memory;
+    const P             pos;
+};
+
+//Makes "map::cells[x][y]" give a Cell view
+class Cell_grid
+{
+public:
+    class Column
+    {
+    public:
+        Column(const int X) :
+            x_(X) {}
+
+        Cell operator[](const int Y) const
+        {
+            return Cell(P(x_, Y));
+        }
+
+    private:
+        const int x_;
+    };
+
+    Column operator[](const int X) const
+    {
+        return Column(X);
+    }
 };
 
 enum class Map_type
@@ -45,7 +96,8 @@ namespace map
 
 extern Player*              player;
 extern int                  dlvl;
-extern Cell                 cells[MAP_W][MAP_H];
+extern Cell_planes          planes;
+extern const Cell_grid      cells;
 extern std::vector<Room*>   room_list;              //Owns the rooms
 extern Room*                room_map[MAP_W][MAP_H]; //Helper array
 
@@ -61,6 +113,18 @@ void reset_map();
 
 Rigid* put(Rigid* const rigid);
 
+//Positions of the rigids which have something to do on new turns (burning,
+//counting down, etc), so that the turn loop does not need to visit every cell.
+//Rigids register themselves when they become active (see Rigid::is_active()).
+void activate_rigid(const P& p);
+
+bool is_rigid_active(const P& p);
+
+const std::vector<P>& active_rigids();
+
+//Unregisters rigids which are no longer active
+void remove_inactive_rigids();
+
 //Makes a copy of the renderers current array
 //TODO: This is weird, and it's unclear how it should be used. Remove?
 //Can it not be copied in the map drawing function instead?
@@ -75,6 +139,19 @@ bool is_pos_seen_by_player(const P& p);
 
 Actor* actor_at_pos(const P& pos, Actor_state state = Actor_state::alive);
 
+//Same as actor_at_pos() for living actors, but looks the position up in an
+//index which is built on the first call after invalidate_actor_index(). This is
+//for code querying many positions (e.g. burning features scorching actors), the
+//index is then built once for all queries.
+//
+//The index is invalidated where actors move (walking, teleporting, knockback,
+//displacing), are added, die, or rise from the dead. Debug builds check each
+//lookup against actor_at_pos().
+Actor* living_actor_at_pos_indexed(const P& pos);
+
+//Must be called after changing the position or state of an actor
+void invalidate_actor_index();
+
 Mob* first_mob_at_pos(const P& pos);
 
 void actor_cells(const std::vector<Actor*>& actors, std::vector<P>& out);
@@ -89,4 +166,16 @@ bool is_area_inside_map(const R& area);
 
 } //map
 
+inline Cell::Cell(const P& p) :
+    is_explored         (map::planes.is_explored            [p.x][p.y]),
+    is_seen_by_player   (map::planes.is_seen_by_player      [p.x][p.y]),
+    is_lit              (map::planes.is_lit                 [p.x][p.y]),
+    is_dark             (map::planes.is_dark                [p.x][p.y]),
+    player_los          (map::planes.player_los             [p.x][p.y]),
+    item                (map::planes.item                   [p.x][p.y]),
+    rigid               (map::planes.rigid                  [p.x][p.y]),
+    rigid_id            (map::planes.rigid_id               [p.x][p.y]),
+    player_visual_memory(map::planes.player_visual_memory   [p.x][p.y]),
+    pos                 (p) {}
+
 #endif
@@ -2,6 +2,7 @@
 #define MAP_PARSING_HPP
 
 #include <vector>
+#include <climits>
 
 #include "config.hpp"
 #include "feature_data.hpp"
@@ -197,6 +198,9 @@ bool cell(const cell_check::Check& method, const P& p);
 //Given a map array of booleans, this will fill a second map array of boolens
 //where the cells are set to true if they are within the specified distance
 //interval of the first array.
+//The distance is the Chebyshev distance, and both ends of the interval are
+//inclusive. Cells closer than the minimum distance are never counted, also
+//next to the map edge.
 //This can be used for example to find all cells up to 3 steps from a wall.
 void cells_within_dist_of_others(const bool in[MAP_W][MAP_H],
                                  bool out[MAP_W][MAP_H],
@@ -230,9 +234,48 @@ public:
     P p_;
 };
 
+//Distance fields - for each cell, the distance to the nearest source cell. These
+//are computed once in linear time, and can then be thresholded or used to order
+//cells by distance (instead of searching neighbourhoods or sorting per query).
+namespace dist_field
+{
+
+//Distance of cells which have no source, or which cannot be reached
+const int unreached = INT_MAX;
+
+//Chebyshev (king move) distance, ignoring anything blocking. Computed with one
+//forward and one backward sweep over the map.
+void chebyshev(const bool sources[MAP_W][MAP_H], int out[MAP_W][MAP_H]);
+
+void chebyshev(const P& source, int out[MAP_W][MAP_H]);
+
+//NOTE: For the number of steps through unblocked cells, use flood_fill::run()
+
+//Fills the vector with all included cells, ordered by ascending distance.
+//Cells further away than the max distance (or unreached) are left out.
+void sorted_cells(const int dist[MAP_W][MAP_H],
+                  const bool include[MAP_W][MAP_H],
+                  std::vector<P>& out,
+                  const int MAX_DIST = unreached - 1);
+
+//Same as above for the Chebyshev distance to a single position, but only the
+//cells within the max distance are visited (the order is the same)
+void sorted_cells_near(const P& origin,
+                       const bool include[MAP_W][MAP_H],
+                       std::vector<P>& out,
+                       const int MAX_DIST);
+
+} //dist_field
+
 namespace flood_fill
 {
 
+//Value of cells which were not reached (blocked, cut off, or beyond the travel
+//limit). The origin is set to zero.
+const int unreached = INT_MAX;
+
+//Breadth first search from p0, setting each reached cell to the number of steps
+//from the origin. If p1 is set (not -1, -1), the search stops when p1 is reached.
 void run(const P& p0,
          const bool blocked[MAP_W][MAP_H],
          int out[MAP_W][MAP_H],
@@ -262,4 +305,35 @@ void run(const P& p0,
 
 } //path_find
 
+//A* search between two positions, for finding a single path without exploring
+//the whole reachable area (use path_find or flood_fill for many-to-one cases)
+namespace a_star
+{
+
+//Finds the cheapest path, where each cell in the cost array is the cost of
+//moving into it (cells with zero or lower cost cannot be entered). The search
+//gives up (returning no path) after expanding the max number of cells - then
+//false is returned, since there may still be a path. If partial paths are
+//allowed, the path to the expanded cell closest to the target is returned
+//instead when giving up.
+//NOTE: The path has the same format as for path_find - it goes from target to
+//origin, not including the origin.
+bool run(const P& p0,
+         const P& p1,
+         const int cost[MAP_W][MAP_H],
+         std::vector<P>& out,
+         const bool ALLOW_DIAGONAL = true,
+         const int MAX_NR_EXPANSIONS = NR_MAP_CELLS,
+         const bool ALLOW_PARTIAL_PATH = false);
+
+//Every cell which is not blocked costs one step
+bool run(const P& p0,
+         const P& p1,
+         const bool blocked[MAP_W][MAP_H],
+         std::vector<P>& out,
+         const bool ALLOW_DIAGONAL = true,
+         const int MAX_NR_EXPANSIONS = NR_MAP_CELLS);
+
+} //a_star
+
 #endif
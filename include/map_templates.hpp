@@ -1,9 +1,6 @@
 #ifndef MAPTEMPLATES_HPP
 #define MAPTEMPLATES_HPP
 
-#include <vector>
-#include <string>
-
 #include "feature_data.hpp"
 #include "item_data.hpp"
 #include "actor_data.hpp"
@@ -21,10 +18,10 @@ enum class Map_templ_id
 
 struct Map_templ_cell
 {
-    Map_templ_cell(char ch,
-                   Feature_id feature_id = Feature_id::END,
-                   Actor_id actor_id = Actor_id::END,
-                   Item_id item_id = Item_id::END) :
+    constexpr Map_templ_cell(char ch = 0,
+                             Feature_id feature_id = Feature_id::END,
+                             Actor_id actor_id = Actor_id::END,
+                             Item_id item_id = Item_id::END) :
         ch          (ch),
         feature_id  (feature_id),
         actor_id    (actor_id),
@@ -36,33 +33,41 @@ struct Map_templ_cell
     Item_id item_id;
 };
 
+//A map template is a block of text rows compiled into the game, and a palette
+//which gives the cell for each character. Nothing is parsed - looking up a cell
+//only reads the character at the position and indexes the palette with it.
+//
+//NOTE: New templates (e.g. prefab rooms) are added by defining the rows and
+//palette in map_templates.cpp, and registering them under a new id.
 struct Map_templ
 {
 public:
-    Map_templ()
-    {
-        cells_.clear();
-    }
+    Map_templ();
+
+    //The rows are stored consecutively, each with a null terminator
+    Map_templ(const char* const rows,
+              const P& dims,
+              const Map_templ_cell* const palette,
+              const size_t NR_PALETTE_CELLS);
 
     const Map_templ_cell& cell(const P& p) const
     {
-        return cells_[p.y][p.x];
-    }
+        const char CH = rows_[(p.y * (dims_.x + 1)) + p.x];
 
-    void add_row(std::vector<Map_templ_cell>& row)
-    {
-        cells_.push_back(row);
+        return palette_[(unsigned char)CH];
     }
 
     P dims() const
     {
-        return P(cells_.back().size(), cells_.size());
+        return dims_;
     }
 
 private:
-    //NOTE: The cells are stored as a "list of rows" - i.e. the inner vector represents the x range,
-    //and the outer vector represents the y range.
-    std::vector< std::vector<Map_templ_cell> > cells_;
+    const char* rows_;
+    P dims_;
+
+    //Indexed by character, unused characters are empty cells
+    Map_templ_cell palette_[256];
 };
 
 namespace map_templ_handling
@@ -2,6 +2,7 @@
 #define MAPBUILD_HPP
 
 #include <vector>
+#include <string>
 
 #include "map_templates.hpp"
 
@@ -57,14 +58,77 @@ void pathfinder_walk(const P& p0,
 
 } //mapgen_utils
 
+//Why the current map was flagged as failed (for map generation statistics)
+enum class Map_invalid_reason
+{
+    none,
+    no_connectable_rooms,
+    connect_rooms,
+    inner_room_entrance,
+    bridges,
+    player_pos,
+    place_stairs,
+    END
+};
+
+//The steps of standard level generation, in the order they are run
+enum class Mapgen_phase
+{
+    init,
+    regions,
+    main_rooms,
+    aux_rooms,
+    sub_rooms,
+    pre_connect,
+    connect_rooms,
+    post_connect,
+    fill_dead_ends,
+    doors,
+    player_pos,
+    decorate,
+    populate,
+    place_stairs,
+    finalize,
+    END
+};
+
+struct Mapgen_phase_stats
+{
+    Mapgen_phase_stats() :
+        nr_runs         (0),
+        nr_rejections   (0),
+        ms_tot          (0.0) {}
+
+    int     nr_runs;
+    int     nr_rejections; //Number of times the map became invalid in this phase
+    double  ms_tot;
+};
+
 namespace mapgen
 {
 
 //This variable is checked at certain points to see if the current map
-//has been flagged as "failed". Setting is_map_valid to false will generally
-//stop map generation, discard the map, and trigger generation of a new map.
+//has been flagged as "failed". Setting is_map_valid to false (through
+//mk_map_invalid) will generally stop map generation, discard the map,
+//and trigger generation of a new map.
 extern bool is_map_valid;
 
+//Only the first reason is kept (the following steps are usually skipped)
+extern Map_invalid_reason invalid_reason;
+
+void mk_map_invalid(const Map_invalid_reason reason);
+
+//Clears the invalid flag and reason, called at the start of building each map
+void mk_map_valid();
+
+//Statistics for each phase of standard level generation, added up for all levels
+//generated since the last reset
+const Mapgen_phase_stats& phase_stats(const Mapgen_phase phase);
+
+void reset_phase_stats();
+
+std::string phase_name(const Mapgen_phase phase);
+
 bool mk_intro_lvl();
 bool mk_std_lvl();
 bool mk_egypt_lvl();
@@ -8,42 +8,55 @@
 #include "rl_utils.hpp"
 #include "cmn.hpp"
 
+//NOTE: The message text is interned by the message log (all messages with the same
+//text point to the same string), so messages can be compared by the string address.
+//Unused strings are removed when many strings have been added, so a message should
+//only be kept in the message log (or briefly, before creating any more messages).
 class Msg
 {
 public:
-    Msg(const std::string& text, const Clr& clr, const int X_POS) :
-        clr_            (clr),
-        x_pos_          (X_POS),
-        str_            (text),
-        repeats_str_    (""),
-        nr_             (1) {}
-
-    Msg() :
-        clr_            (clr_white),
-        x_pos_          (0),
-        str_            (""),
-        repeats_str_    (""),
-        nr_             (1) {}
+    Msg(const std::string& text, const Clr& clr, const int X_POS);
+
+    Msg();
 
     void str_with_repeats(std::string& str_ref) const
     {
-        str_ref = str_ + (nr_ > 1 ? repeats_str_ : "");
+        str_ref = *str_;
+
+        if (nr_ > 1)
+        {
+            str_ref += "(x" + to_str(nr_) + ")";
+        }
     }
 
-    void str_raw(std::string& str_ref) const {str_ref = str_;}
+    void str_raw(std::string& str_ref) const {str_ref = *str_;}
+
+    bool is_same_str(const Msg& other) const
+    {
+        return str_ == other.str_;
+    }
 
     void incr_repeat()
     {
         ++nr_;
-        repeats_str_ = "(x" + to_str(nr_) + ")";
+    }
+
+    //Only used by the message log when it rebuilds the interned strings
+    const std::string* interned_str() const
+    {
+        return str_;
+    }
+
+    void set_interned_str(const std::string* const str)
+    {
+        str_ = str;
     }
 
     Clr clr_;
     int x_pos_;
 
 private:
-    std::string str_;
-    std::string repeats_str_;
+    const std::string* str_;
     int nr_;
 };
 
@@ -70,7 +83,10 @@ void clear();
 
 void add_line_to_history(const std::string& line_to_add);
 
-const std::vector< std::vector<Msg> >& history();
+//The history only keeps the most recent lines, the oldest line has index zero
+int history_size();
+
+const std::vector<Msg>& history_line(const int IDX);
 
 } //log
 
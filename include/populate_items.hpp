@@ -4,6 +4,9 @@
 namespace populate_items
 {
 
+//Builds the spawn tables from the item data
+void init();
+
 void mk_items_on_floor();
 
 } //Populate_items
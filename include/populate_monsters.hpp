@@ -8,6 +8,9 @@
 namespace populate_mon
 {
 
+//Builds the spawn tables from the actor data
+void init();
+
 void try_spawn_due_to_time_passed();
 
 void populate_std_lvl();
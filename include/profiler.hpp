@@ -0,0 +1,68 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+//-----------------------------------------------------------------------------
+//Uncomment to enable profiling (or build with -DPROFILING)
+//-----------------------------------------------------------------------------
+//#define PROFILING 1
+
+//Scoped timing zones, written as a Chrome trace event file when the game exits
+//(open it with chrome://tracing or https://ui.perfetto.dev). Zones nest, so the
+//trace shows how the time of e.g. a monster turn is split between its AI steps.
+//
+//When profiling is not enabled, the zone macros expand to nothing.
+//
+//Usage:
+//  PROFILE_ZONE("render::draw_map_state");
+//  PROFILE_ZONE_DETAIL("Mon::act", name_a());    <- Detail shown in the trace
+
+#ifdef PROFILING
+
+#include <string>
+#include <chrono>
+
+namespace profiler
+{
+
+void init();
+
+//Writes the trace file
+void cleanup();
+
+class Zone
+{
+public:
+    Zone(const char* const name);
+
+    Zone(const char* const name, const std::string& detail);
+
+    ~Zone();
+
+private:
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+    const char* const                               name_;
+    std::string                                     detail_;
+    const std::chrono::steady_clock::time_point     start_;
+};
+
+} //profiler
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#define PROFILE_ZONE(name) \
+    profiler::Zone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+
+#define PROFILE_ZONE_DETAIL(name, detail) \
+    profiler::Zone PROFILE_CONCAT(profile_zone_, __LINE__)(name, detail)
+
+#else //PROFILING not defined
+
+#define PROFILE_ZONE(name)
+#define PROFILE_ZONE_DETAIL(name, detail)
+
+#endif //PROFILING
+
+#endif
@@ -64,9 +64,17 @@ void init();
 void cleanup();
 
 //Draws the whole "map state" including character lines, log, etc
+//NOTE: Does nothing while fast-forwarding
 void draw_map_state(const Update_screen update = Update_screen::yes,
                     Cell_overlay overlay[MAP_W][MAP_H] = nullptr);
 
+//Fast-forwarding is used while the player is in a multi-turn action (e.g.
+//resting) or cannot act. The map state is then not drawn until fast-forwarding
+//is turned off, which also happens on any message or interrupted action.
+void set_fast_forward(const bool IS_FAST_FORWARD);
+
+bool is_fast_forwarding();
+
 void update_screen();
 
 void clear_screen();
@@ -0,0 +1,79 @@
+#ifndef RUN_LOG_HPP
+#define RUN_LOG_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+//Append-only binary log of finished runs (player deaths, wins, and completed
+//bot runs). All records have the same size, so a record is appended or read by
+//seeking directly to its offset - the file is never rewritten.
+//
+//A separate small index file keeps the record numbers of the best scoring runs
+//(not counting bot runs), so that the high score screen does not need to read
+//the whole log. The index is rebuilt from the log if it is missing or out of
+//date (e.g. if the game crashed between writing the log and the index).
+
+const size_t run_record_str_len = 32;
+
+//NOTE: Only fixed size fields - the struct is written to the file as it is. If
+//the layout is changed, the version number in run_log.cpp must be increased.
+struct Run_record
+{
+    Run_record();
+
+    char    date_and_time[run_record_str_len];
+    char    name[run_record_str_len];
+
+    //What killed the player, e.g. "fire" or "insanity" (empty if the player
+    //did not die)
+    char    death_cause[run_record_str_len];
+
+    //Name of the monster acting when the player died (empty if the player died
+    //on its own turn, or did not die)
+    char    killer_name[run_record_str_len];
+
+    int32_t score;
+    int32_t xp;
+    int32_t lvl;
+    int32_t dlvl;
+    int32_t ins;
+    int32_t is_win;
+    int32_t bg;
+    int32_t is_bot;
+    int32_t nr_turns;
+    int32_t nr_kills;
+};
+
+namespace run_log
+{
+
+const std::string default_file_path = "data/run_log";
+
+const size_t max_nr_top_records = 250;
+
+//Copies the string into a record field (truncated if too long)
+void set_str(char* const dst, const std::string& src);
+
+void append(const Run_record& record,
+            const std::string& file_path = default_file_path);
+
+size_t nr_records(const std::string& file_path = default_file_path);
+
+//Returns false if there is no such record
+bool read_record(const size_t IDX,
+                 Run_record& out,
+                 const std::string& file_path = default_file_path);
+
+//Reads all records, in the order they were added
+void read_all(std::vector<Run_record>& out,
+              const std::string& file_path = default_file_path);
+
+//Reads the best scoring non-bot records (at most max_nr_top_records), sorted
+//by score, highest first
+void read_top(std::vector<Run_record>& out,
+              const std::string& file_path = default_file_path);
+
+} //run_log
+
+#endif
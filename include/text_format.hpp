@@ -7,14 +7,31 @@
 namespace text_format
 {
 
+//A range of characters in a string
+struct Text_span
+{
+    size_t begin;
+    size_t len;
+};
+
 //Reads a line of space separated words, and splits them into several lines with the
 //given maximum width. If any single word in the "line" parameter is longer than the
 //maximum width, we do not bother to split that word (the entire word is simply added
 //to the output vector, breaking the maximum width).
-void split(std::string line,
+void split(const std::string& line,
            const int MAX_W,
            std::vector<std::string>& out);
 
+//Same as split(), but only finds the lines as ranges of the input (nothing is copied)
+void split_spans(const std::string& line,
+                 const int MAX_W,
+                 std::vector<Text_span>& out);
+
+//Same as split(), but the result is remembered for the most recently split texts, so
+//that text which is drawn repeatedly (e.g. in description boxes) is only split once.
+//The returned lines are valid until the next call.
+const std::vector<std::string>& split_cached(const std::string& line, const int MAX_W);
+
 void space_separated_list(const std::string& line,
                           std::vector<std::string>& out);
 
@@ -0,0 +1,25 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <cstddef>
+#include <functional>
+
+//Worker threads for splitting read-only calculations over all cores. The jobs
+//must not modify any shared game state, and should write their results only to
+//storage owned by the job (e.g. the monster it was run for).
+namespace thread_pool
+{
+
+void init();
+
+void cleanup();
+
+int nr_threads();
+
+//Runs the function once for each index from zero to NR_JOBS - 1, spread over
+//the worker threads and the calling thread. Returns when all jobs are done.
+void run(const size_t NR_JOBS, const std::function<void(const size_t)>& job);
+
+} //thread_pool
+
+#endif
@@ -19,6 +19,7 @@
 #include "input.hpp"
 #include "marker.hpp"
 #include "look.hpp"
+#include "highscore.hpp"
 
 Actor::Actor() :
     pos             (),
@@ -446,6 +447,8 @@ void Actor::teleport()
 
     pos = tgt_pos;
 
+    map::invalidate_actor_index();
+
     map::player->update_fov();
 
     std::vector<Actor*> player_seen_actors;
@@ -813,6 +816,11 @@ Actor_died Actor::hit(int dmg,
                                   IS_ON_BOTTOMLESS          ||
                                   IS_DMG_ENOUGH_TO_DESTROY;
 
+        if (is_player())
+        {
+            highscore::set_death_cause(dmg_type);
+        }
+
         die(IS_DESTROYED, !IS_ON_BOTTOMLESS, !IS_ON_BOTTOMLESS);
 
         return Actor_died::yes;
@@ -844,6 +852,8 @@ Actor_died Actor::hit_spi(const int DMG, const Verbosity verbosity)
         if (is_player())
         {
             msg_log::add("All my spirit is depleted, I am devoid of life!", clr_msg_bad);
+
+            highscore::set_death_cause(Dmg_type::spirit);
         }
         else //Is monster
         {
@@ -917,6 +927,8 @@ void Actor::die(const bool IS_DESTROYED,
         state_ = Actor_state::corpse;
     }
 
+    map::invalidate_actor_index();
+
     if (!is_player())
     {
         //This is a monster
@@ -85,6 +85,18 @@ Actor_data_t data[size_t(Actor_id::END)];
 namespace
 {
 
+//The parts of the actor data which are modified during a game
+struct Session_data
+{
+    int         nr_left_allowed_to_spawn;
+    int         nr_kills;
+    std::string name_a;
+    std::string name_the;
+};
+
+//Initial values of the session data, stored when the data list is built
+Session_data session_data_start_[size_t(Actor_id::END)];
+
 void init_data_list()
 {
     Actor_data_t d;
@@ -3041,10 +3053,37 @@ void init_data_list()
 void init()
 {
     TRACE_FUNC_BEGIN;
+
     init_data_list();
+
+    for (size_t i = 0; i < size_t(Actor_id::END); ++i)
+    {
+        const Actor_data_t& d       = data[i];
+        Session_data&       start   = session_data_start_[i];
+
+        start.nr_left_allowed_to_spawn  = d.nr_left_allowed_to_spawn;
+        start.nr_kills                  = d.nr_kills;
+        start.name_a                    = d.name_a;
+        start.name_the                  = d.name_the;
+    }
+
     TRACE_FUNC_END;
 }
 
+void init_session()
+{
+    for (size_t i = 0; i < size_t(Actor_id::END); ++i)
+    {
+        Actor_data_t&       d       = data[i];
+        const Session_data& start   = session_data_start_[i];
+
+        d.nr_left_allowed_to_spawn  = start.nr_left_allowed_to_spawn;
+        d.nr_kills                  = start.nr_kills;
+        d.name_a                    = start.name_a;
+        d.name_the                  = start.name_the;
+    }
+}
+
 void save()
 {
     for (int i = 0; i < int(Actor_id::END); ++i)
@@ -27,6 +27,7 @@
 #include "popup.hpp"
 #include "fov.hpp"
 #include "text_format.hpp"
+#include "profiler.hpp"
 
 Mon::Mon() :
     Actor                       (),
@@ -41,7 +42,8 @@ Mon::Mon() :
     tgt_                        (nullptr),
     waiting_                    (false),
     shock_caused_cur_           (0.0),
-    has_given_xp_for_spotting_  (false) {}
+    has_given_xp_for_spotting_  (false),
+    los_cache_                  () {}
 
 Mon::~Mon()
 {
@@ -64,6 +66,8 @@ void Mon::on_actor_turn()
 //tell the actor to "do something".
 void Mon::act()
 {
+    PROFILE_ZONE_DETAIL("Mon::act", name_a());
+
 #ifndef NDEBUG
     //Sanity check - verify that monster is not outside the map
     if (!map::is_pos_inside_map(pos, false))
@@ -103,6 +107,8 @@ void Mon::act()
     if (prop_handler_->has_prop(Prop_id::conflict))
     {
         //Monster is conflicted (e.g. by player ring/amulet)
+        PROFILE_ZONE("Mon::act: pick target");
+
         tgt_bucket = game_time::actors;
 
         bool hard_blocked_los[MAP_W][MAP_H];
@@ -129,6 +135,8 @@ void Mon::act()
     }
     else //Not conflicted
     {
+        PROFILE_ZONE("Mon::act: pick target");
+
         seen_foes(tgt_bucket);
 
         //If not aware, remove player from target bucket
@@ -205,6 +213,8 @@ void Mon::act()
         leader_ != map::player          &&
         (tgt_ == nullptr || tgt_ == map::player))
     {
+        PROFILE_ZONE("Mon::act: look");
+
         if (ai::info::look_become_player_aware(*this))
         {
             return;
@@ -216,6 +226,8 @@ void Mon::act()
         leader_ != map::player                          &&
         tgt_ == map::player)
     {
+        PROFILE_ZONE("Mon::act: make room for friend");
+
         if (ai::action::make_room_for_friend(*this))
         {
             return;
@@ -224,6 +236,8 @@ void Mon::act()
 
     if (rnd::one_in(5))
     {
+        PROFILE_ZONE("Mon::act: cast spell");
+
         if (ai::action::try_cast_random_spell(*this))
         {
             return;
@@ -232,15 +246,21 @@ void Mon::act()
 
     if (data_->ai[size_t(Ai_id::attacks)] && tgt_)
     {
+        PROFILE_ZONE("Mon::act: attack");
+
         if (try_attack(*tgt_))
         {
             return;
         }
     }
 
-    if (ai::action::try_cast_random_spell(*this))
     {
-        return;
+        PROFILE_ZONE("Mon::act: cast spell");
+
+        if (ai::action::try_cast_random_spell(*this))
+        {
+            return;
+        }
     }
 
     int erratic_move_pct = int(data_->erratic_move_pct);
@@ -293,6 +313,8 @@ void Mon::act()
         leader_ != map::player                              &&
         !IS_TERRIFIED)
     {
+        PROFILE_ZONE("Mon::act: path to player");
+
         ai::info::try_set_path_to_player(*this, path);
     }
 
@@ -311,6 +333,8 @@ void Mon::act()
 
     if (data_->ai[size_t(Ai_id::moves_to_leader)] && !IS_TERRIFIED)
     {
+        PROFILE_ZONE("Mon::act: path to leader");
+
         ai::info::try_set_path_to_leader(*this, path);
 
         if (ai::action::step_path(*this, path))
@@ -331,6 +355,8 @@ void Mon::act()
         else //No LOS to lair
         {
             //Try to use pathfinder to travel to lair
+            PROFILE_ZONE("Mon::act: path to lair");
+
             ai::info::try_set_path_to_lair_if_no_los(*this, path, lair_pos_);
 
             if (ai::action::step_path(*this, path))
@@ -353,6 +379,20 @@ void Mon::act()
     game_time::tick();
 }
 
+void Mon::prepare_los(const bool hard_blocked_los[MAP_W][MAP_H]) const
+{
+    for (const Actor* const other : game_time::actors)
+    {
+        if (
+            other != this       &&
+            other->is_alive()   &&
+            fov::is_in_fov_range(pos, other->pos))
+        {
+            los_cache_.check_cell(pos, other->pos, hard_blocked_los);
+        }
+    }
+}
+
 bool Mon::can_see_actor(const Actor& other, const bool hard_blocked_los[MAP_W][MAP_H]) const
 {
     if (this == &other || !other.is_alive())
@@ -382,7 +422,7 @@ bool Mon::can_see_actor(const Actor& other, const bool hard_blocked_los[MAP_W][M
         return false;
     }
 
-    const Los_result los = fov::check_cell(pos, other.pos, hard_blocked_los);
+    const Los_result los = los_cache_.check_cell(pos, other.pos, hard_blocked_los);
 
     //LOS blocked hard (e.g. a wall)?
     if (los.is_blocked_hard)
@@ -478,6 +518,8 @@ void Mon::move(Dir dir)
     {
         pos = tgt_p;
 
+        map::invalidate_actor_index();
+
         //Bump features in target cell (i.e. to trigger traps)
         std::vector<Mob*> mobs;
         game_time::mobs_at_pos(pos, mobs);
@@ -974,6 +1016,8 @@ void Zuul::place_hook()
         //player getting XP. Instead, simply set the dead state to destroyed.
         state_                      = Actor_state::destroyed;
 
+        map::invalidate_actor_index();
+
         Actor* actor                = actor_factory::mk(Actor_id::cultist_priest, pos);
         auto& priest_prop_handler   = actor->prop_handler();
 
@@ -1950,6 +1994,7 @@ Did_action Zombie::try_resurrect()
         if (!actor)
         {
             state_  = Actor_state::alive;
+            map::invalidate_actor_index();
             hp_     = (hp_max(true) * 3) / 4;
             glyph_  = data_->glyph;
             tile_   = data_->tile;
@@ -2339,7 +2384,7 @@ Animated_wpn::Animated_wpn() :
     Mon                     (),
     nr_turns_until_drop_    (rnd::range(75, 125)) {}
 
-std::string Animated_wpn::name_the() const
+const std::string& Animated_wpn::name_the() const
 {
     Item* item = inv_->item_in_slot(Slot_id::wpn);
 
@@ -2349,10 +2394,12 @@ std::string Animated_wpn::name_the() const
                                         Item_ref_inf::yes,
                                         Item_ref_att_inf::none);
 
-    return "The floating " + name;
+    name_the_ = "The floating " + name;
+
+    return name_the_;
 }
 
-std::string Animated_wpn::name_a() const
+const std::string& Animated_wpn::name_a() const
 {
     Item* item = inv_->item_in_slot(Slot_id::wpn);
 
@@ -2362,7 +2409,9 @@ std::string Animated_wpn::name_a() const
                                         Item_ref_inf::yes,
                                         Item_ref_att_inf::none);
 
-    return "A floating " + name;
+    name_a_ = "A floating " + name;
+
+    return name_a_;
 }
 
 char Animated_wpn::glyph() const
@@ -1,6 +1,7 @@
 #include "actor_player.hpp"
 
 #include <string>
+#include <algorithm>
 
 #include "init.hpp"
 #include "render.hpp"
@@ -36,6 +37,32 @@
 #include "save_handling.hpp"
 #include "insanity.hpp"
 #include "reload.hpp"
+#include "profiler.hpp"
+#include "highscore.hpp"
+
+namespace
+{
+
+//The player's field of view when the map was last drawn on the player's turn
+bool seen_at_last_draw_[MAP_W][MAP_H];
+
+void draw_and_remember_map(const Update_screen update)
+{
+    render::draw_map_state(update);
+
+    map::cpy_render_array_to_visual_memory();
+
+    std::copy_n(*map::planes.is_seen_by_player, NR_MAP_CELLS, *seen_at_last_draw_);
+}
+
+bool is_fov_changed_since_draw()
+{
+    const bool* const seen = *map::planes.is_seen_by_player;
+
+    return !std::equal(seen, seen + NR_MAP_CELLS, *seen_at_last_draw_);
+}
+
+} //namespace
 
 Player::Player() :
     Actor(),
@@ -581,6 +608,7 @@ void Player::incr_insanity()
         const std::string msg = "My mind can no longer withstand what it has grasped. "
                                 "I am hopelessly lost.";
         popup::show_msg(msg, true, "Insane!", Sfx_id::insanity_rise);
+        highscore::set_death_cause("insanity");
         die(true, false, false);
         return;
     }
@@ -703,16 +731,33 @@ void Player::act()
            !prop_handler_->has_prop(Prop_id::infected));
 #endif // NDEBUG
 
-    render::draw_map_state();
+    //Multi-turn actions are fast-forwarded - nothing is drawn until the action
+    //finishes or is interrupted (e.g. by a message about a monster coming into
+    //view, or by taking damage)
+    const bool IS_FAST_FORWARDING = is_in_multi_turn_action();
+
+    render::set_fast_forward(IS_FAST_FORWARDING);
 
     if (!is_alive())
     {
+        render::draw_map_state();
         return;
     }
 
-    render::draw_map_state();
+    if (!IS_FAST_FORWARDING)
+    {
+        draw_and_remember_map(Update_screen::yes);
+    }
+    else if (is_fov_changed_since_draw())
+    {
+        //The map is still drawn (but not presented) when the field of view has
+        //changed, to keep the memory of the seen cells up to date
+        render::set_fast_forward(false);
 
-    map::cpy_render_array_to_visual_memory();
+        draw_and_remember_map(Update_screen::no);
+
+        render::set_fast_forward(true);
+    }
 
     if (tgt_ && tgt_->state() != Actor_state::alive)
     {
@@ -878,7 +923,7 @@ void Player::update_tmp_shock()
     if (prop_handler_->allow_see())
     {
         //Temporary shock from darkness
-        Cell& cell = map::cells[pos.x][pos.y];
+        Cell cell = map::cells[pos.x][pos.y];
 
         if (cell.is_dark && !cell.is_lit)
         {
@@ -1279,8 +1324,18 @@ void Player::on_log_msg_printed()
     quick_move_dir_             = Dir::END;
 }
 
+bool Player::is_in_multi_turn_action() const
+{
+    return
+        active_medical_bag              ||
+        wait_turns_left > 0             ||
+        nr_quick_move_steps_left_ > 0;
+}
+
 void Player::interrupt_actions()
 {
+    render::set_fast_forward(false);
+
     //Abort browsing inventory
     inv_handling::scr_to_open_on_new_turn           = Inv_scr::none;
     inv_handling::browser_idx_to_set_on_new_turn    = 0;
@@ -1365,7 +1420,7 @@ void Player::move(Dir dir)
     if (dir != Dir::center)
     {
         //Check if map features are blocking (used later)
-        Cell& cell = map::cells[tgt.x][tgt.y];
+        Cell cell = map::cells[tgt.x][tgt.y];
         bool is_features_allow_move = cell.rigid->can_move(*this);
 
         std::vector<Mob*> mobs;
@@ -1512,6 +1567,8 @@ void Player::move(Dir dir)
 
             pos = tgt;
 
+            map::invalidate_actor_index();
+
             const int FREE_STEP_EVERY_N_TURN =
                 player_bon::traits[(size_t)Trait::mobile]       ? 3 :
                 player_bon::traits[(size_t)Trait::lithe]        ? 4 :
@@ -1754,17 +1811,15 @@ void Player::add_light_hook(bool light_map[MAP_W][MAP_H]) const
 
 void Player::update_fov()
 {
-    for (int x = 0; x < MAP_W; ++x)
-    {
-        for (int y = 0; y < MAP_H; ++y)
-        {
-            Cell& cell = map::cells[x][y];
+    PROFILE_ZONE("Player::update_fov");
 
-            cell.is_seen_by_player              = false;
-            cell.player_los.is_blocked_hard     = true;
-            cell.player_los.is_blocked_by_drk   = false;
-        }
-    }
+    Cell_planes& planes = map::planes;
+
+    Los_result los_blocked;
+    los_blocked.is_blocked_hard = true;
+
+    std::fill_n(*planes.is_seen_by_player,  NR_MAP_CELLS, false);
+    std::fill_n(*planes.player_los,         NR_MAP_CELLS, los_blocked);
 
     if (prop_handler_->allow_see())
     {
@@ -1785,42 +1840,39 @@ void Player::update_fov()
         {
             for (int y = fov_lmt.p0.y; y <= fov_lmt.p1.y; ++y)
             {
-                const Los_result&   los     = fov[x][y];
-                Cell&               cell    = map::cells[x][y];
+                const Los_result& los = fov[x][y];
 
-                cell.is_seen_by_player      = !los.is_blocked_hard && !los.is_blocked_by_drk;
-                cell.player_los             = los;
+                planes.is_seen_by_player[x][y]  = !los.is_blocked_hard && !los.is_blocked_by_drk;
+                planes.player_los[x][y]         = los;
             }
         }
 
-        map::cells[pos.x][pos.y].is_seen_by_player = true;
+        planes.is_seen_by_player[pos.x][pos.y] = true;
 
         fov_hack();
     }
 
     if (init::is_cheat_vision_enabled)
     {
-        for (int x = 0; x < MAP_W; ++x)
-        {
-            for (int y = 0; y < MAP_H; ++y)
-            {
-                map::cells[x][y].is_seen_by_player = true;
-            }
-        }
+        std::fill_n(*planes.is_seen_by_player, NR_MAP_CELLS, true);
     }
 
     //Explore
+    const cell_check::Blocks_move_cmn blocks_move(false);
+
     for (int x = 0; x < MAP_W; ++x)
     {
         for (int y = 0; y < MAP_H; ++y)
         {
-            Cell& cell = map::cells[x][y];
-            const bool IS_BLOCKING = cell_check::Blocks_move_cmn(false).check(cell);
+            if (!planes.is_seen_by_player[x][y])
+            {
+                continue;
+            }
 
             //Do not explore dark floor cells
-            if (cell.is_seen_by_player && (!cell.is_dark || IS_BLOCKING))
+            if (!planes.is_dark[x][y] || blocks_move.check(map::cells[x][y]))
             {
-                cell.is_explored = true;
+                planes.is_explored[x][y] = true;
             }
         }
     }
@@ -1855,7 +1907,7 @@ void Player::fov_hack()
                             (!adj_cell.is_dark || adj_cell.is_lit)  &&
                             !blocked[p_adj.x][p_adj.y])
                         {
-                            Cell& cell                      = map::cells[x][y];
+                            Cell cell                       = map::cells[x][y];
                             cell.is_seen_by_player          = true;
                             cell.player_los.is_blocked_hard = false;
 
@@ -5,6 +5,7 @@
 #include "map.hpp"
 #include "feature_mob.hpp"
 #include "feature_door.hpp"
+#include "feature_trap.hpp"
 #include "actor_mon.hpp"
 #include "line_calc.hpp"
 #include "map_parsing.hpp"
@@ -497,6 +498,70 @@ bool step_to_lair_if_los(Mon& mon, const P& lair_p)
 namespace info
 {
 
+namespace
+{
+
+//Max number of cells the pathfinder expands for one monster path (see
+//find_mon_path())
+const int path_max_nr_expansions = NR_MAP_CELLS / 2;
+
+//Extra cost of moving through a closed door, on top of the step itself
+const int door_open_extra_cost = 1;
+const int door_bash_extra_cost = 4;
+
+//Extra cost of moving into cells with traps or fire
+const int hazard_extra_cost = 8;
+
+//Most monster paths are short, so the search is limited in the number of
+//expanded cells. If the limit is reached (e.g. when chasing the player around
+//most of the map), the monster heads for the searched cell closest to the target
+//instead - the path is searched for again next turn anyway.
+void find_mon_path(const P& p0,
+                   const P& p1,
+                   const int cost[MAP_W][MAP_H],
+                   std::vector<P>& path)
+{
+    a_star::run(p0, p1, cost, path, true, path_max_nr_expansions, true);
+}
+
+} //namespace
+
+void mk_move_costs(const Actor& mover,
+                   const bool blocked[MAP_W][MAP_H],
+                   int out[MAP_W][MAP_H])
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            if (blocked[x][y])
+            {
+                out[x][y] = 0;
+                continue;
+            }
+
+            const Rigid* const f = map::cells[x][y].rigid;
+
+            out[x][y] = 1;
+
+            bool is_hazard = f->burn_state() == Burn_state::burning;
+
+            if (f->id() == Feature_id::trap)
+            {
+                //The player does not know about hidden traps (monsters do)
+                const Trap* const trap = static_cast<const Trap*>(f);
+
+                is_hazard = is_hazard || !mover.is_player() || !trap->is_hidden();
+            }
+
+            if (is_hazard)
+            {
+                out[x][y] += hazard_extra_cost;
+            }
+        }
+    }
+}
+
 bool look_become_player_aware(Mon& mon)
 {
     if (!mon.is_alive())
@@ -582,10 +647,10 @@ void try_set_path_to_lair_if_no_los(Mon& mon, std::vector<P>& path, const P& lai
                        blocked,
                        Map_parse_mode::append);
 
-        path_find::run(mon.pos,
-                       lair_p,
-                       blocked,
-                       path);
+        int cost[MAP_W][MAP_H];
+        mk_move_costs(mon, blocked, cost);
+
+        find_mon_path(mon.pos, lair_p, cost, path);
 
         return;
     }
@@ -624,7 +689,10 @@ void try_set_path_to_leader(Mon& mon, std::vector<P>& path)
                            blocked,
                            Map_parse_mode::append);
 
-            path_find::run(mon.pos, leader->pos, blocked, path);
+            int cost[MAP_W][MAP_H];
+            mk_move_costs(mon, blocked, cost);
+
+            find_mon_path(mon.pos, leader->pos, cost, path);
             return;
         }
     }
@@ -696,8 +764,30 @@ void try_set_path_to_player(Mon& mon, std::vector<P>& path)
                        blocked,
                        Map_parse_mode::append);
 
+        int cost[MAP_W][MAP_H];
+        mk_move_costs(mon, blocked, cost);
+
+        //Closed doors which are not blocking (i.e. the monster can open or bash
+        //them) cost the time it takes to get through
+        const Actor_data_t& d = mon.data();
+
+        for (int x = X0; x < X1; ++x)
+        {
+            for (int y = Y0; y < Y1; ++y)
+            {
+                auto* const f = map::cells[x][y].rigid;
+
+                if (cost[x][y] > 0 && f->id() == Feature_id::door && !f->can_move(mon))
+                {
+                    cost[x][y] += d.can_open_doors ?
+                                  door_open_extra_cost :
+                                  door_bash_extra_cost;
+                }
+            }
+        }
+
         //Find a path
-        path_find::run(mon.pos, player_pos, blocked, path);
+        find_mon_path(mon.pos, player_pos, cost, path);
     }
 }
 
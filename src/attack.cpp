@@ -255,9 +255,7 @@ Ranged_att_data::Ranged_att_data(Actor* const attacker,
     aim_pos             (aim_pos),
     hit_chance_tot      (0),
     intended_aim_lvl    (Actor_size::none),
-    defender_size       (Actor_size::none),
-    verb_player_attacks (wpn.data().ranged.att_msgs.player),
-    verb_other_attacks  (wpn.data().ranged.att_msgs.other)
+    defender_size       (Actor_size::none)
 {
     Actor* const actor_aimed_at = map::actor_at_pos(aim_pos);
 
@@ -819,7 +817,7 @@ void print_melee_msg_and_mk_snd(const Melee_att_data& att_data, const Wpn& wpn)
     }
 }
 
-void print_ranged_init_msgs(const Ranged_att_data& data)
+void print_ranged_init_msgs(const Ranged_att_data& data, const Wpn& wpn)
 {
     if (!data.attacker)
     {
@@ -830,7 +828,7 @@ void print_ranged_init_msgs(const Ranged_att_data& data)
     if (data.attacker == map::player)
     {
         //Player is attacking
-        msg_log::add("I " + data.verb_player_attacks + ".");
+        msg_log::add("I " + wpn.data().ranged.att_msgs.player + ".");
     }
     else //Attacker is monster
     {
@@ -841,8 +839,8 @@ void print_ranged_init_msgs(const Ranged_att_data& data)
 
             if (map::cells[p.x][p.y].is_seen_by_player)
             {
-                const std::string attacker_name = data.attacker->name_the();
-                const std::string attack_verb   = data.verb_other_attacks;
+                const std::string& attacker_name    = data.attacker->name_the();
+                const std::string& attack_verb      = wpn.data().ranged.att_msgs.other;
 
                 msg_log::add(attacker_name + " " + attack_verb + ".",
                              clr_white,
@@ -924,7 +922,7 @@ void projectile_fire(Actor* const attacker,
 
     const int DELAY = config::delay_projectile_draw() / (IS_MACHINE_GUN ? 2 : 1);
 
-    print_ranged_init_msgs(*projectiles[0]->att_data);
+    print_ranged_init_msgs(*projectiles[0]->att_data, wpn);
 
     const bool stop_at_tgt = aim_lvl == Actor_size::floor;
     const int cheb_trvl_lim = 30;
@@ -991,6 +989,8 @@ void projectile_fire(Actor* const attacker,
     const int SIZE_OF_PATH_PLUS_ONE =
         path.size() + (NR_PROJECTILES - 1) * NR_CELL_JUMPS_MG_PROJECTILES;
 
+    std::vector<Mob*> mobs;
+
     for (int i = 1; i < SIZE_OF_PATH_PLUS_ONE; ++i)
     {
         for (int p_cnt = 0; p_cnt < NR_PROJECTILES; ++p_cnt)
@@ -1041,15 +1041,14 @@ void projectile_fire(Actor* const attacker,
 
                 proj->is_seen_by_player = map::cells[proj->pos.x][proj->pos.y].is_seen_by_player;
 
-                //Get attack data again for every cell traveled through
-                auto atta_data = new Ranged_att_data(attacker,
-                                                     origin,    //Attacker origin
-                                                     aim_pos,   //Aim pos
-                                                     proj->pos, //Cur pos
-                                                     wpn,
-                                                     aim_lvl);
-
-                proj->set_att_data(atta_data);
+                //Get attack data again for every cell traveled through (reusing
+                //the attack data object of the projectile)
+                *proj->att_data = Ranged_att_data(attacker,
+                                                  origin,       //Attacker origin
+                                                  aim_pos,      //Aim pos
+                                                  proj->pos,    //Cur pos
+                                                  wpn,
+                                                  aim_lvl);
 
                 const P draw_pos(proj->pos);
 
@@ -1136,7 +1135,6 @@ void projectile_fire(Actor* const attacker,
                 }
 
                 //Projectile hit feature?
-                std::vector<Mob*> mobs;
                 game_time::mobs_at_pos(proj->pos, mobs);
                 Feature* feature_blocking_shot = nullptr;
 
@@ -1311,7 +1309,7 @@ void shotgun(Actor& attacker, const Wpn& wpn, const P& aim_pos)
                                            attacker.pos,
                                            wpn);
 
-    print_ranged_init_msgs(data);
+    print_ranged_init_msgs(data, wpn);
 
     const Actor_size intended_aim_lvl = data.intended_aim_lvl;
 
@@ -1453,7 +1451,7 @@ void shotgun(Actor& attacker, const Wpn& wpn, const P& aim_pos)
 
             snd_emit::run(snd);
 
-            Cell& cell = map::cells[cur_pos.x][cur_pos.y];
+            Cell cell = map::cells[cur_pos.x][cur_pos.y];
 
             if (cell.is_seen_by_player)
             {
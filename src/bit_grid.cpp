@@ -0,0 +1,416 @@
+#include "bit_grid.hpp"
+
+#include <algorithm>
+
+#include "init.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+typedef Bit_grid::Row Row;
+
+namespace
+{
+
+static_assert(MAP_W > 64 && MAP_W < 128, "Map width must use both row halves");
+
+const Row row_empty = {0, 0};
+
+//All bits inside the map set
+const Row row_full = {~uint64_t(0), (uint64_t(1) << (MAP_W - 64)) - 1};
+
+#ifdef __SSE2__
+
+__m128i load(const Row& r)
+{
+    return _mm_load_si128((const __m128i*)&r);
+}
+
+Row store(const __m128i v)
+{
+    Row r;
+    _mm_store_si128((__m128i*)&r, v);
+    return r;
+}
+
+Row row_or(const Row& a, const Row& b)
+{
+    return store(_mm_or_si128(load(a), load(b)));
+}
+
+Row row_and(const Row& a, const Row& b)
+{
+    return store(_mm_and_si128(load(a), load(b)));
+}
+
+//a & ~b
+Row row_and_not(const Row& a, const Row& b)
+{
+    return store(_mm_andnot_si128(load(b), load(a)));
+}
+
+//Shifts cells towards higher x, for 0 < N < 64
+Row row_shl(const Row& r, const int N)
+{
+    const __m128i v     = load(r);
+    const __m128i shift = _mm_cvtsi32_si128(N);
+    const __m128i carry = _mm_cvtsi32_si128(64 - N);
+
+    //The low half is moved into the high half before shifting out the carry
+    const __m128i lo_to_hi = _mm_slli_si128(v, 8);
+
+    const __m128i res = _mm_or_si128(_mm_sll_epi64(v, shift),
+                                     _mm_srl_epi64(lo_to_hi, carry));
+
+    return row_and(store(res), row_full);
+}
+
+//Shifts cells towards lower x, for 0 < N < 64
+Row row_shr(const Row& r, const int N)
+{
+    const __m128i v     = load(r);
+    const __m128i shift = _mm_cvtsi32_si128(N);
+    const __m128i carry = _mm_cvtsi32_si128(64 - N);
+
+    const __m128i hi_to_lo = _mm_srli_si128(v, 8);
+
+    const __m128i res = _mm_or_si128(_mm_srl_epi64(v, shift),
+                                     _mm_sll_epi64(hi_to_lo, carry));
+
+    return store(res);
+}
+
+#else //No SSE2
+
+Row row_or(const Row& a, const Row& b)
+{
+    return {a.lo | b.lo, a.hi | b.hi};
+}
+
+Row row_and(const Row& a, const Row& b)
+{
+    return {a.lo & b.lo, a.hi & b.hi};
+}
+
+Row row_and_not(const Row& a, const Row& b)
+{
+    return {a.lo & ~b.lo, a.hi & ~b.hi};
+}
+
+Row row_shl(const Row& r, const int N)
+{
+    const Row res = {r.lo << N, (r.hi << N) | (r.lo >> (64 - N))};
+
+    return row_and(res, row_full);
+}
+
+Row row_shr(const Row& r, const int N)
+{
+    return {(r.lo >> N) | (r.hi << (64 - N)), r.hi >> N};
+}
+
+#endif //__SSE2__
+
+//Shifts of any distance (cells shifted outside the map are lost)
+Row row_shift(const Row& r, const int N)
+{
+    if (N == 0)
+    {
+        return r;
+    }
+
+    const int N_ABS = N < 0 ? -N : N;
+
+    if (N_ABS >= MAP_W)
+    {
+        return row_empty;
+    }
+
+    Row res = r;
+
+    //Split in steps, since the row shifts only handle shifts below 64
+    for (int shifted = 0; shifted < N_ABS; shifted += 63)
+    {
+        const int STEP = std::min(63, N_ABS - shifted);
+
+        res = N > 0 ? row_shl(res, STEP) : row_shr(res, STEP);
+    }
+
+    return res;
+}
+
+bool is_row_empty(const Row& r)
+{
+    return r.lo == 0 && r.hi == 0;
+}
+
+//Expands each set cell one step to the left and right
+Row row_dilated_once(const Row& r)
+{
+    return row_or(r, row_or(row_shl(r, 1), row_shr(r, 1)));
+}
+
+} //namespace
+
+Bit_grid::Bit_grid()
+{
+    clear();
+}
+
+Bit_grid::Bit_grid(const bool in[MAP_W][MAP_H])
+{
+    from_array(in);
+}
+
+void Bit_grid::from_array(const bool in[MAP_W][MAP_H])
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        Row& row = rows_[y];
+
+        row = row_empty;
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            if (in[x][y])
+            {
+                uint64_t& half = x < 64 ? row.lo : row.hi;
+
+                half |= uint64_t(1) << (x & 63);
+            }
+        }
+    }
+}
+
+void Bit_grid::to_array(bool out[MAP_W][MAP_H]) const
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        const Row& row = rows_[y];
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            const uint64_t half = x < 64 ? row.lo : row.hi;
+
+            out[x][y] = (half >> (x & 63)) & 1;
+        }
+    }
+}
+
+void Bit_grid::clear()
+{
+    for (Row& row : rows_)
+    {
+        row = row_empty;
+    }
+}
+
+void Bit_grid::set(const P& p, const bool VALUE)
+{
+    ASSERT(p.x >= 0 && p.y >= 0 && p.x < MAP_W && p.y < MAP_H);
+
+    uint64_t& half = p.x < 64 ? rows_[p.y].lo : rows_[p.y].hi;
+
+    const uint64_t bit = uint64_t(1) << (p.x & 63);
+
+    if (VALUE)
+    {
+        half |= bit;
+    }
+    else
+    {
+        half &= ~bit;
+    }
+}
+
+bool Bit_grid::at(const P& p) const
+{
+    ASSERT(p.x >= 0 && p.y >= 0 && p.x < MAP_W && p.y < MAP_H);
+
+    const uint64_t half = p.x < 64 ? rows_[p.y].lo : rows_[p.y].hi;
+
+    return (half >> (p.x & 63)) & 1;
+}
+
+bool Bit_grid::is_empty() const
+{
+    for (const Row& row : rows_)
+    {
+        if (!is_row_empty(row))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Bit_grid& Bit_grid::operator|=(const Bit_grid& other)
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        rows_[y] = row_or(rows_[y], other.rows_[y]);
+    }
+
+    return *this;
+}
+
+Bit_grid& Bit_grid::operator&=(const Bit_grid& other)
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        rows_[y] = row_and(rows_[y], other.rows_[y]);
+    }
+
+    return *this;
+}
+
+Bit_grid& Bit_grid::subtract(const Bit_grid& other)
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        rows_[y] = row_and_not(rows_[y], other.rows_[y]);
+    }
+
+    return *this;
+}
+
+void Bit_grid::invert()
+{
+    for (Row& row : rows_)
+    {
+        row = row_and_not(row_full, row);
+    }
+}
+
+Bit_grid Bit_grid::dilated(const int DIST) const
+{
+    if (DIST <= 0)
+    {
+        return *this;
+    }
+
+    //Chebyshev dilation is separable - first expand each row horizontally...
+    Row hor[MAP_H];
+
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        Row row = rows_[y];
+
+        if (!is_row_empty(row))
+        {
+            for (int i = 0; i < DIST; ++i)
+            {
+                row = row_dilated_once(row);
+            }
+        }
+
+        hor[y] = row;
+    }
+
+    //...then combine the rows vertically
+    Bit_grid res;
+
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        const int Y0 = std::max(0,          y - DIST);
+        const int Y1 = std::min(MAP_H - 1,  y + DIST);
+
+        Row row = row_empty;
+
+        for (int y_other = Y0; y_other <= Y1; ++y_other)
+        {
+            row = row_or(row, hor[y_other]);
+        }
+
+        res.rows_[y] = row;
+    }
+
+    return res;
+}
+
+Bit_grid Bit_grid::eroded(const int DIST) const
+{
+    Bit_grid res = *this;
+
+    res.invert();
+
+    res = res.dilated(DIST);
+
+    res.invert();
+
+    return res;
+}
+
+Bit_grid Bit_grid::dist_band(const Range& dist_interval) const
+{
+    const int MIN_DIST = std::max(0, dist_interval.min);
+    const int MAX_DIST = dist_interval.max;
+
+    if (MAX_DIST < MIN_DIST)
+    {
+        return Bit_grid();
+    }
+
+    if (MIN_DIST == 0)
+    {
+        return dilated(MAX_DIST);
+    }
+
+    //The cells at exactly distance d from a set cell form a ring. The top and
+    //bottom of the ring are the horizontally dilated rows moved d steps up and
+    //down, and the sides are the vertically dilated rows moved d steps left
+    //and right. Both dilations are grown by one step for each distance.
+    Row hor[MAP_H];
+    Row ver[MAP_H];
+
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        hor[y] = ver[y] = rows_[y];
+    }
+
+    Bit_grid res;
+
+    for (int d = 1; d <= MAX_DIST; ++d)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            hor[y] = row_dilated_once(hor[y]);
+
+            if (y - d >= 0)
+            {
+                ver[y] = row_or(ver[y], rows_[y - d]);
+            }
+
+            if (y + d < MAP_H)
+            {
+                ver[y] = row_or(ver[y], rows_[y + d]);
+            }
+        }
+
+        if (d < MIN_DIST)
+        {
+            continue;
+        }
+
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            Row row = row_or(row_shift(ver[y], d), row_shift(ver[y], -d));
+
+            if (y - d >= 0)
+            {
+                row = row_or(row, hor[y - d]);
+            }
+
+            if (y + d < MAP_H)
+            {
+                row = row_or(row, hor[y + d]);
+            }
+
+            res.rows_[y] = row_or(res.rows_[y], row);
+        }
+    }
+
+    return res;
+}
@@ -23,6 +23,8 @@
 #include "explosion.hpp"
 #include "render.hpp"
 #include "sdl_wrapper.hpp"
+#include "highscore.hpp"
+#include "ai.hpp"
 
 namespace bot
 {
@@ -38,7 +40,7 @@ void show_map_and_freeze(const std::string& msg)
     {
         for (int y = 0; y < MAP_H; ++y)
         {
-            Cell& cell = map::cells[x][y];
+            Cell cell = map::cells[x][y];
 
             cell.is_explored = true;
             cell.is_seen_by_player = true;
@@ -111,10 +113,13 @@ void find_stair_path()
         show_map_and_freeze("Player on blocked position");
     }
 
-    path_find::run(player_p,
-                   stair_p,
-                   blocked,
-                   path_);
+    int cost[MAP_W][MAP_H];
+    ai::info::mk_move_costs(*map::player, blocked, cost);
+
+    a_star::run(player_p,
+                stair_p,
+                cost,
+                path_);
 
     if (path_.empty())
     {
@@ -196,6 +201,8 @@ void act()
     //Check if we are finished with the current run, if so, go back to DLVL 1
     if (map::dlvl >= DLVL_LAST)
     {
+        highscore::on_bot_run_done();
+
         TRACE << "Starting new run on first dungeon level" << std::endl;
         map_travel::init();
         map::dlvl = 1;
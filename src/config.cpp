@@ -18,11 +18,12 @@ namespace config
 namespace
 {
 
-const int NR_OPTIONS  = 14;
+const int NR_OPTIONS  = 15;
 const int OPT_Y0      = 1;
 
 std::string  font_name_                 = "";
 bool    is_fullscr_                     = false;
+bool    is_hw_map_drawing_              = false;
 bool    is_tiles_wall_full_square_      = false;
 bool    is_text_mode_wall_full_square_  = false;
 bool    is_ranged_wpn_meleee_prompt_    = false;
@@ -108,6 +109,7 @@ void set_default_variables()
     font_name_                      = "images/16x24_v1.png";
     set_cell_px_dims_from_font_name();
     is_fullscr_                     = false;
+    is_hw_map_drawing_              = false;
     is_tiles_wall_full_square_      = false;
     is_text_mode_wall_full_square_  = true;
     is_intro_lvl_skipped_           = false;
@@ -263,6 +265,11 @@ void player_sets_option(const Menu_browser* const browser, const int OPTION_VALU
     break;
 
     case 13:
+        is_hw_map_drawing_ = !is_hw_map_drawing_;
+        render::init();
+        break;
+
+    case 14:
         set_default_variables();
         set_cell_px_dims_from_font_name();
         set_cell_px_dim_dependent_variables();
@@ -481,6 +488,21 @@ void draw(const Menu_browser* const browser, const int OPTION_VALUES_X_POS)
                       browser->y() == opt_nr ? clr_menu_highlight : clr_menu_drk);
     opt_nr++;
 
+    render::draw_text("Hardware accelerated map drawing",
+                      Panel::screen,
+                      P(0, OPT_Y0 + opt_nr),
+                      browser->y() == opt_nr ? clr_menu_highlight : clr_menu_drk);
+    render::draw_text(":",
+                      Panel::screen,
+                      P(X1 - 2, OPT_Y0 + opt_nr),
+                      browser->y() == opt_nr ? clr_menu_highlight : clr_menu_drk);
+    str = is_hw_map_drawing_ ? "Yes" : "No";
+    render::draw_text(str,
+                      Panel::screen,
+                      P(X1, OPT_Y0 + opt_nr),
+                      browser->y() == opt_nr ? clr_menu_highlight : clr_menu_drk);
+    opt_nr++;
+
     render::draw_text("Reset to defaults",
                       Panel::screen,
                       P(0, OPT_Y0 + opt_nr + 1),
@@ -599,6 +621,14 @@ void set_variables_from_lines(std::vector<std::string>& lines)
     delay_explosion_ = to_int(cur_line);
     lines.erase(begin(lines));
 
+    //NOTE: Config files written by older versions do not have this option
+    if (!lines.empty())
+    {
+        cur_line = lines.front();
+        is_hw_map_drawing_ = cur_line == "1";
+        lines.erase(begin(lines));
+    }
+
     TRACE_FUNC_END;
 }
 
@@ -637,6 +667,7 @@ void set_lines_from_variables(std::vector<std::string>& lines)
     lines.push_back(to_str(delay_projectile_draw_));
     lines.push_back(to_str(delay_shotgun_));
     lines.push_back(to_str(delay_explosion_));
+    lines.push_back(is_hw_map_drawing_              ? "1" : "0");
     TRACE_FUNC_END;
 }
 
@@ -737,6 +768,11 @@ int char_lines_px_h()
     return char_lines_px_h_;
 }
 
+bool is_hw_map_drawing()
+{
+    return is_hw_map_drawing_;
+}
+
 bool is_text_mode_wall_full_square()
 {
     return is_text_mode_wall_full_square_;
@@ -180,11 +180,8 @@ void draw_pick_bg(const std::vector<Bg>& bgs, const Menu_browser& browser)
             continue;
         }
 
-        std::vector<std::string> formatted_lines;
-
-        text_format::split(descr_entry,
-                           DESCR_W,
-                           formatted_lines);
+        const std::vector<std::string>& formatted_lines =
+            text_format::split_cached(descr_entry, DESCR_W);
 
         for (const std::string& line : formatted_lines)
         {
@@ -346,11 +343,8 @@ void draw_pick_trait(const std::vector<Trait>& traits, const Menu_browser& brows
 
     std::string descr = player_bon::trait_descr(trait_marked);
 
-    std::vector<std::string> formatted_descr;
-
-    text_format::split(descr,
-                       DESCR_W,
-                       formatted_descr);
+    const std::vector<std::string>& formatted_descr =
+        text_format::split_cached(descr, DESCR_W);
 
     for (const std::string& str : formatted_descr)
     {
@@ -12,6 +12,8 @@
 #include "feature_rigid.hpp"
 #include "feature_mob.hpp"
 #include "dungeon_master.hpp"
+#include "gas.hpp"
+#include "profiler.hpp"
 
 namespace
 {
@@ -125,6 +127,8 @@ void run(const P& origin,
          Prop* const prop,
          const Clr* const clr_override)
 {
+    PROFILE_ZONE("explosion::run");
+
     const int RADI = EXPLOSION_STD_RADI + RADI_CHANGE;
 
     const R area = explosion_area(origin, RADI);
@@ -199,7 +203,7 @@ void run(const P& origin,
             if (expl_type == Expl_type::expl)
             {
                 //Damage environment
-                Cell& cell = map::cells[pos.x][pos.y];
+                Cell cell = map::cells[pos.x][pos.y];
                 cell.rigid->hit(Dmg_type::physical, Dmg_method::explosion, nullptr);
 
                 const int ROLLS = EXPL_DMG_ROLLS - radi;
@@ -231,7 +235,7 @@ void run(const P& origin,
                 //Add smoke
                 if (rnd::fraction(6, 10))
                 {
-                    game_time::add_mob(new Smoke(pos, rnd::range(2, 4)));
+                    gas::add(Gas_id::smoke, pos, rnd::range(2, 4));
                 }
             }
 
@@ -262,7 +266,7 @@ void run(const P& origin,
                 //If property is burning, also apply it to corpses and environment
                 if (prop->id() == Prop_id::burning)
                 {
-                    Cell& cell = map::cells[pos.x][pos.y];
+                    Cell cell = map::cells[pos.x][pos.y];
                     cell.rigid->hit(Dmg_type::fire, Dmg_method::elemental, nullptr);
 
                     for (Actor* corpse : corpses_here)
@@ -320,7 +324,7 @@ void run_smoke_explosion_at(const P& origin, const int RADI_CHANGE)
         {
             if (!blocked[pos.x][pos.y])
             {
-                game_time::add_mob(new Smoke(pos, rnd::range(25, 30)));
+                gas::add(Gas_id::smoke, pos, rnd::range(25, 30));
             }
         }
     }
@@ -666,11 +666,9 @@ void init_data_list()
     d.move_rules.set_can_move_cmn();
     add_to_list_and_reset(d);
     //---------------------------------------------------------------------------
+    //NOTE: Smoke is not a feature object, it is stored in the gas field (see
+    //gas.hpp) - this data is only used for drawing it
     d.id = Feature_id::smoke;
-    d.mk_obj = [](const P & p)
-    {
-        return new Smoke(p);
-    };
     d.glyph = '*';
     d.tile = Tile_id::smoke;
     d.move_rules.set_can_move_cmn();
@@ -10,6 +10,7 @@
 #include "player_bon.hpp"
 #include "render.hpp"
 #include "map_parsing.hpp"
+#include "fov.hpp"
 
 //---------------------------------------------------INHERITED FUNCTIONS
 Door::Door(const P& feature_pos, const Rigid* const mimic_feature,
@@ -774,6 +775,8 @@ void Door::try_close(Actor* actor_trying)
         {
             is_open_ = false;
 
+            fov::on_los_changed();
+
             if (IS_PLAYER)
             {
                 Snd snd("", Sfx_id::door_close, Ignore_msg_if_origin_seen::yes, pos_,
@@ -800,6 +803,8 @@ void Door::try_close(Actor* actor_trying)
             {
                 is_open_ = false;
 
+                fov::on_los_changed();
+
                 if (IS_PLAYER)
                 {
                     Snd snd("", Sfx_id::door_close, Ignore_msg_if_origin_seen::yes, pos_,
@@ -887,6 +892,8 @@ void Door::try_open(Actor* actor_trying)
             TRACE << "Tryer can see, opening" << std::endl;
             is_open_ = true;
 
+            fov::on_los_changed();
+
             if (IS_PLAYER)
             {
                 Snd snd("",
@@ -929,6 +936,8 @@ void Door::try_open(Actor* actor_trying)
                 TRACE << "Tryer is blind, but open succeeded anyway" << std::endl;
                 is_open_ = true;
 
+                fov::on_los_changed();
+
                 if (IS_PLAYER)
                 {
                     Snd snd("",
@@ -1032,5 +1041,8 @@ Did_open Door::open(Actor* const actor_opening)
     is_open_   = true;
     is_secret_ = false;
     is_stuck_  = false;
+
+    fov::on_los_changed();
+
     return Did_open::yes;
 }
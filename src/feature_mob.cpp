@@ -15,113 +15,6 @@
 #include "msg_log.hpp"
 #include "map_parsing.hpp"
 
-//------------------------------------------------------------------- SMOKE
-void Smoke::on_new_turn()
-{
-    auto* actor = map::actor_at_pos(pos_);
-
-    if (actor)
-    {
-        const bool IS_PLAYER = actor == map::player;
-
-        //TODO: There needs to be some criteria here, so that e.g. a statue-monster or a
-        //very alien monster can't get blinded by smoke (but do not use is_humanoid - rats,
-        //wolves etc should definitely be blinded by smoke).
-
-        //Perhaps add some variable like "has_eyes"?
-
-        bool is_blind_prot = false;
-
-        if (IS_PLAYER)
-        {
-            auto&       inv                 = map::player->inv();
-            auto* const player_head_item    = inv.slots_[int(Slot_id::head)].item;
-            auto* const player_body_item    = inv.slots_[int(Slot_id::body)].item;
-
-            if (player_head_item && player_head_item->data().id == Item_id::gas_mask)
-            {
-                is_blind_prot = true;
-
-                //This may destroy the gasmask
-                static_cast<Gas_mask*>(player_head_item)->decr_turns_left(inv);
-            }
-
-            if (player_body_item && player_body_item->data().id == Item_id::armor_asb_suit)
-            {
-                is_blind_prot = true;
-            }
-        }
-
-        //Blinded?
-        if (!is_blind_prot && rnd::one_in(4))
-        {
-            if (IS_PLAYER)
-            {
-                msg_log::add("I am getting smoke in my eyes.");
-            }
-
-            actor->prop_handler().try_add(
-                new Prop_blind(Prop_turns::specific, rnd::range(1, 3)));
-        }
-
-        //Coughing?
-        if (rnd::one_in(4) && !actor->has_prop(Prop_id::rBreath))
-        {
-            std::string snd_msg = "";
-
-            if (IS_PLAYER)
-            {
-                msg_log::add("I cough.", clr_msg_bad);
-            }
-            else //Is monster
-            {
-                if (actor->is_humanoid())
-                {
-                    snd_msg = "I hear coughing.";
-                }
-            }
-
-            const auto alerts = IS_PLAYER ? Alerts_mon::yes : Alerts_mon::no;
-
-            snd_emit::run(Snd(snd_msg,
-                              Sfx_id::END,
-                              Ignore_msg_if_origin_seen::yes,
-                              actor->pos,
-                              actor,
-                              Snd_vol::low,
-                              alerts));
-        }
-    }
-
-    //If not permanent, count down turns left and possibly erase self
-    if (nr_turns_left_ > -1)
-    {
-        --nr_turns_left_;
-
-        if (nr_turns_left_ <= 0)
-        {
-            game_time::erase_mob(this, true);
-        }
-    }
-}
-
-std::string Smoke::name(const Article article)  const
-{
-    std::string ret = "";
-
-    if (article == Article::the)
-    {
-        ret += "the ";
-    }
-
-    return ret + "smoke";
-}
-
-Clr Smoke::clr() const
-{
-    return clr_gray;
-}
-
 //------------------------------------------------------------------- DYNAMITE
 void Lit_dynamite::on_new_turn()
 {
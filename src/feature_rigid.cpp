@@ -20,6 +20,7 @@
 #include "pickup.hpp"
 #include "dungeon_master.hpp"
 #include "sound.hpp"
+#include "gas.hpp"
 
 //--------------------------------------------------------------------- RIGID
 Rigid::Rigid(const P& feature_pos) :
@@ -61,7 +62,7 @@ void Rigid::on_new_turn()
         //TODO: Hit dead actors
 
         //Hit actor standing on feature
-        auto* actor = map::actor_at_pos(pos_);
+        auto* actor = map::living_actor_at_pos_indexed(pos_);
 
         if (actor)
         {
@@ -119,7 +120,9 @@ void Rigid::on_new_turn()
         {
             burn_state_ = Burn_state::has_burned;
 
-            if (on_finished_burning() == Was_destroyed::yes)
+            const Was_destroyed was_destroyed = on_finished_burning();
+
+            if (was_destroyed == Was_destroyed::yes)
             {
                 return;
             }
@@ -134,9 +137,12 @@ void Rigid::on_new_turn()
             {
                 map::cells[p.x][p.y].rigid->hit(Dmg_type::fire, Dmg_method::elemental);
 
-                actor = map::actor_at_pos(p);
+                actor = map::living_actor_at_pos_indexed(p);
 
-                if (actor) {scorch_actor(*actor);}
+                if (actor)
+                {
+                    scorch_actor(*actor);
+                }
             }
         }
 
@@ -149,7 +155,7 @@ void Rigid::on_new_turn()
             {
                 if (!cell_check::Blocks_move_cmn(false).check(map::cells[p.x][p.y]))
                 {
-                    game_time::add_mob(new Smoke(p, 10));
+                    gas::add(Gas_id::smoke, p, 10);
                 }
             }
         }
@@ -173,6 +179,8 @@ void Rigid::try_start_burning(const bool IS_MSG_ALLOWED)
         }
 
         burn_state_ = Burn_state::burning;
+
+        map::activate_rigid(pos_);
     }
 }
 
@@ -334,6 +342,16 @@ void Rigid::try_put_gore()
 void Rigid::corrupt_color()
 {
     nr_turns_color_corrupted_ = rnd::range(200, 220);
+
+    map::activate_rigid(pos_);
+}
+
+bool Rigid::is_active() const
+{
+    return
+        burn_state_ == Burn_state::burning  ||
+        nr_turns_color_corrupted_ > 0       ||
+        is_active_hook();
 }
 
 Clr Rigid::clr() const
@@ -1087,6 +1105,16 @@ void Stairs::on_new_turn_hook()
     ASSERT(!map::cells[pos_.x][pos_.y].item);
 }
 
+bool Stairs::is_active_hook() const
+{
+    //The new turn hook only does a debug check
+#ifdef NDEBUG
+    return false;
+#else
+    return true;
+#endif
+}
+
 void Stairs::bump(Actor& actor_bumping)
 {
     if (actor_bumping.is_player())
@@ -1105,6 +1133,7 @@ void Stairs::bump(Actor& actor_bumping)
         {
         case 0:
             map::player->pos = pos_;
+            map::invalidate_actor_index();
             msg_log::clear();
             msg_log::add("I descend the stairs.");
             render::draw_map_state();
@@ -1113,6 +1142,7 @@ void Stairs::bump(Actor& actor_bumping)
 
         case 1:
             map::player->pos = pos_;
+            map::invalidate_actor_index();
             save_handling::save_game();
             init::quit_to_main_menu = true;
             break;
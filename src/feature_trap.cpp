@@ -263,6 +263,10 @@ void Trap::trigger_start(const Actor* actor)
         //NOTE: This will reset number of turns  until triggered
         trigger_trap(nullptr);
     }
+    else //Count down on new turns
+    {
+        map::activate_rigid(pos_);
+    }
 
     TRACE_FUNC_END_VERBOSE;
 }
@@ -429,6 +433,7 @@ void Trap::disarm()
         if (rnd::one_in(TRIGGER_ONE_IN_N))
         {
             map::player->pos = pos_;
+            map::invalidate_actor_index();
 
             trigger_trap(map::player);
         }
@@ -4,6 +4,7 @@
 
 #include <math.h>
 #include <vector>
+#include <algorithm>
 
 #include "line_calc.hpp"
 #include "map.hpp"
@@ -11,6 +12,15 @@
 namespace fov
 {
 
+namespace
+{
+
+//Incremented whenever line of sight may have changed, caches with an older
+//generation are discarded on their next use
+unsigned int los_generation_ = 1;
+
+} //namespace
+
 R get_fov_rect(const P& p)
 {
     const int RADI = FOV_STD_RADI_INT;
@@ -129,4 +139,44 @@ void run(const P& p0,
     out[p0.x][p0.y].is_blocked_hard = false;
 }
 
+void on_los_changed()
+{
+    ++los_generation_;
+}
+
 } //fov
+
+Los_cache::Los_cache() :
+    origin_     (-1, -1),
+    generation_ (0) {}
+
+Los_result Los_cache::check_cell(const P& p0,
+                                 const P& p1,
+                                 const bool hard_blocked[MAP_W][MAP_H])
+{
+    if (!fov::is_in_fov_range(p0, p1))
+    {
+        return fov::check_cell(p0, p1, hard_blocked);
+    }
+
+    if (p0 != origin_ || generation_ != fov::los_generation_)
+    {
+        origin_     = p0;
+        generation_ = fov::los_generation_;
+
+        std::fill_n(*is_stored_, FOV_STD_W_INT * FOV_STD_W_INT, false);
+    }
+
+    const int X = p1.x - p0.x + FOV_STD_RADI_INT;
+    const int Y = p1.y - p0.y + FOV_STD_RADI_INT;
+
+    Los_result& result = results_[X][Y];
+
+    if (!is_stored_[X][Y])
+    {
+        result          = fov::check_cell(p0, p1, hard_blocked);
+        is_stored_[X][Y] = true;
+    }
+
+    return result;
+}
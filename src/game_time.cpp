@@ -1,6 +1,7 @@
 #include "game_time.hpp"
 
 #include <vector>
+#include <algorithm>
 
 #include "init.hpp"
 #include "feature_rigid.hpp"
@@ -20,6 +21,10 @@
 #include "item.hpp"
 #include "save_handling.hpp"
 #include "msg_log.hpp"
+#include "fov.hpp"
+#include "thread_pool.hpp"
+#include "profiler.hpp"
+#include "gas.hpp"
 
 namespace game_time
 {
@@ -38,6 +43,111 @@ int     cur_turn_type_pos_  = 0;
 size_t  cur_actor_idx_      = 0;
 int     turn_nr_            = 0;
 
+//Computes what each monster can see, for all monsters in parallel. This only
+//reads the map and actors, and stores the results in each monster's line of
+//sight cache - the monsters then use these results when acting (results which
+//are outdated by the time a monster acts are simply calculated again).
+void run_mon_perception()
+{
+    PROFILE_ZONE("game_time::run_mon_perception");
+
+    bool blocked_los[MAP_W][MAP_H];
+    map_parse::run(cell_check::Blocks_los(), blocked_los);
+
+    std::vector<Mon*> mons;
+
+    for (Actor* const actor : actors)
+    {
+        if (!actor->is_player() && actor->is_alive())
+        {
+            mons.push_back(static_cast<Mon*>(actor));
+        }
+    }
+
+    thread_pool::run(mons.size(), [&](const size_t i)
+    {
+        PROFILE_ZONE("Mon::prepare_los");
+
+        mons[i]->prepare_los(blocked_los);
+    });
+}
+
+#ifndef NDEBUG
+//The state which a rigid's new turn could change
+struct Rigid_state
+{
+    Rigid_state(const P& p) :
+        rigid       (map::cells[p.x][p.y].rigid),
+        id          (rigid->id()),
+        burn_state  (rigid->burn_state()),
+        clr         (rigid->clr()),
+        is_active   (rigid->is_active()) {}
+
+    bool operator==(const Rigid_state& other) const
+    {
+        return
+            rigid       == other.rigid      &&
+            id          == other.id         &&
+            burn_state  == other.burn_state &&
+            is_clr_equal(clr, other.clr)    &&
+            is_active   == other.is_active;
+    }
+
+    const Rigid*    rigid;
+    Feature_id      id;
+    Burn_state      burn_state;
+    Clr             clr;
+    bool            is_active;
+};
+
+//Verifies that skipping the rigids which are not registered as active does not
+//change anything - the new turn is run for each skipped rigid, and the state it
+//could change (the rigid itself, actor hit points, and the mobs) must be the
+//same afterwards
+void verify_inactive_rigids()
+{
+    std::vector<int> hp_before;
+
+    for (const Actor* const actor : actors)
+    {
+        hp_before.push_back(actor->hp());
+    }
+
+    const size_t NR_MOBS_BEFORE = mobs.size();
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            const P p(x, y);
+
+            if (map::is_rigid_active(p))
+            {
+                continue;
+            }
+
+            const Rigid_state before(p);
+
+            ASSERT(!before.is_active);
+
+            map::cells[x][y].rigid->on_new_turn();
+
+            ASSERT(Rigid_state(p) == before);
+            ASSERT(!map::is_rigid_active(p));
+        }
+    }
+
+    ASSERT(actors.size() == hp_before.size());
+
+    for (size_t i = 0; i < actors.size(); ++i)
+    {
+        ASSERT(actors[i]->hp() == hp_before[i]);
+    }
+
+    ASSERT(mobs.size() == NR_MOBS_BEFORE);
+}
+#endif //NDEBUG
+
 void run_std_turn_events()
 {
     if (is_magic_descend_nxt_std_turn)
@@ -103,15 +213,29 @@ void run_std_turn_events()
         }
     }
 
-    //New turn for rigids
-    for (int x = 0; x < MAP_W; ++x)
+    //New turn for rigids - only the active rigids have anything to do (using a
+    //copied vector, since rigids may be activated during the loop, e.g. by
+    //spreading fire - these start on the next turn)
+#ifndef NDEBUG
+    if (config::is_bot_playing())
     {
-        for (int y = 0; y < MAP_H; ++y)
-        {
-            map::cells[x][y].rigid->on_new_turn();
-        }
+        verify_inactive_rigids();
+    }
+#endif //NDEBUG
+
+    const std::vector<P> active_rigids_cpy = map::active_rigids();
+
+    map::invalidate_actor_index();
+
+    for (const P& p : active_rigids_cpy)
+    {
+        map::cells[p.x][p.y].rigid->on_new_turn();
     }
 
+    map::remove_inactive_rigids();
+
+    gas::on_new_turn();
+
     //New turn for mobs (using a copied vector, since mobs may get destroyed)
     const std::vector<Mob*> mobs_cpy = mobs;
 
@@ -154,6 +278,12 @@ void run_std_turn_events()
     {
         audio::try_play_amb(100);
     }
+
+    //The events above may have changed the light - update it now, so the
+    //perception results are not discarded when the next actor acts
+    update_light_map();
+
+    run_mon_perception();
 }
 
 void run_atomic_turn_events()
@@ -238,6 +368,8 @@ void mobs_at_pos(const P& p, std::vector<Mob*>& vector_ref)
 void add_mob(Mob* const f)
 {
     mobs.push_back(f);
+
+    fov::on_los_changed();
 }
 
 void erase_mob(Mob* const f, const bool DESTROY_OBJECT)
@@ -252,6 +384,8 @@ void erase_mob(Mob* const f, const bool DESTROY_OBJECT)
             }
 
             mobs.erase(it);
+
+            fov::on_los_changed();
             return;
         }
     }
@@ -265,6 +399,8 @@ void erase_all_mobs()
     }
 
     mobs.clear();
+
+    fov::on_los_changed();
 }
 
 void add_actor(Actor* actor)
@@ -292,6 +428,8 @@ void add_actor(Actor* actor)
 #endif // NDEBUG
 
     actors.push_back(actor);
+
+    map::invalidate_actor_index();
 }
 
 void reset_turn_type_and_actor_counters()
@@ -305,6 +443,8 @@ void reset_turn_type_and_actor_counters()
 //spawn more monsters etc.)
 void tick(const Pass_time pass_time)
 {
+    PROFILE_ZONE("game_time::tick");
+
     run_atomic_turn_events();
 
     auto* actor = cur_actor();
@@ -382,48 +522,50 @@ void tick(const Pass_time pass_time)
 
 void update_light_map()
 {
+    PROFILE_ZONE("game_time::update_light_map");
+
+    Cell_planes& planes = map::planes;
+
     bool light[MAP_W][MAP_H];
+    bool prev_light[MAP_W][MAP_H];
 
-    for (int x = 0; x < MAP_W; ++x)
-    {
-        for (int y = 0; y < MAP_H; ++y)
-        {
-            map::cells[x][y].is_lit = light[x][y] = false;
-        }
-    }
+    std::copy_n(*planes.is_lit, NR_MAP_CELLS, *prev_light);
 
-    //Do not add light on Leng
-    if (map_travel::map_type() == Map_type::leng)
-    {
-        return;
-    }
+    std::fill_n(*planes.is_lit, NR_MAP_CELLS, false);
+    std::fill_n(*light,         NR_MAP_CELLS, false);
 
-    for (const auto* const a : actors)
+    //Do not add light on Leng
+    if (map_travel::map_type() != Map_type::leng)
     {
-        a->add_light(light);
-    }
+        for (const auto* const a : actors)
+        {
+            a->add_light(light);
+        }
 
-    for (const auto* const m : mobs)
-    {
-        m->add_light(light);
-    }
+        for (const auto* const m : mobs)
+        {
+            m->add_light(light);
+        }
 
-    for (int x = 0; x < MAP_W; ++x)
-    {
-        for (int y = 0; y < MAP_H; ++y)
+        for (int x = 0; x < MAP_W; ++x)
         {
-            map::cells[x][y].rigid->add_light(light);
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                planes.rigid[x][y]->add_light(light);
+            }
         }
     }
 
     //Copy the temp values to the real light map
     //NOTE: This must be done separately - it cannot be done in the map loop above
-    for (int x = 0; x < MAP_W; ++x)
+    std::copy_n(*light, NR_MAP_CELLS, *planes.is_lit);
+
+    const bool IS_CHANGED = !std::equal(*light, *light + NR_MAP_CELLS, *prev_light);
+
+    //Stored line of sight results depend on the light
+    if (IS_CHANGED)
     {
-        for (int y = 0; y < MAP_H; ++y)
-        {
-            map::cells[x][y].is_lit = light[x][y];
-        }
+        fov::on_los_changed();
     }
 }
 
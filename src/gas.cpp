@@ -0,0 +1,220 @@
+#include "gas.hpp"
+
+#include <algorithm>
+
+#include "init.hpp"
+#include "map.hpp"
+#include "game_time.hpp"
+#include "actor_player.hpp"
+#include "inventory.hpp"
+#include "item.hpp"
+#include "msg_log.hpp"
+#include "sound.hpp"
+#include "profiler.hpp"
+#include "fov.hpp"
+
+namespace gas
+{
+
+namespace
+{
+
+//Number of turns left for each gas and cell
+uint8_t turns_left_[size_t(Gas_id::END)][MAP_W][MAP_H];
+
+bool is_any_gas_ = false;
+
+bool is_los_blocking(const Gas_id id)
+{
+    return id == Gas_id::smoke;
+}
+
+void run_smoke_effects(Actor& actor)
+{
+    const bool IS_PLAYER = &actor == map::player;
+
+    //TODO: There needs to be some criteria here, so that e.g. a statue-monster or a
+    //very alien monster can't get blinded by smoke (but do not use is_humanoid - rats,
+    //wolves etc should definitely be blinded by smoke).
+
+    //Perhaps add some variable like "has_eyes"?
+
+    bool is_blind_prot = false;
+
+    if (IS_PLAYER)
+    {
+        auto&       inv                 = map::player->inv();
+        auto* const player_head_item    = inv.slots_[int(Slot_id::head)].item;
+        auto* const player_body_item    = inv.slots_[int(Slot_id::body)].item;
+
+        if (player_head_item && player_head_item->data().id == Item_id::gas_mask)
+        {
+            is_blind_prot = true;
+
+            //This may destroy the gasmask
+            static_cast<Gas_mask*>(player_head_item)->decr_turns_left(inv);
+        }
+
+        if (player_body_item && player_body_item->data().id == Item_id::armor_asb_suit)
+        {
+            is_blind_prot = true;
+        }
+    }
+
+    //Blinded?
+    if (!is_blind_prot && rnd::one_in(4))
+    {
+        if (IS_PLAYER)
+        {
+            msg_log::add("I am getting smoke in my eyes.");
+        }
+
+        actor.prop_handler().try_add(
+            new Prop_blind(Prop_turns::specific, rnd::range(1, 3)));
+    }
+
+    //Coughing?
+    if (rnd::one_in(4) && !actor.has_prop(Prop_id::rBreath))
+    {
+        std::string snd_msg = "";
+
+        if (IS_PLAYER)
+        {
+            msg_log::add("I cough.", clr_msg_bad);
+        }
+        else //Is monster
+        {
+            if (actor.is_humanoid())
+            {
+                snd_msg = "I hear coughing.";
+            }
+        }
+
+        const auto alerts = IS_PLAYER ? Alerts_mon::yes : Alerts_mon::no;
+
+        snd_emit::run(Snd(snd_msg,
+                          Sfx_id::END,
+                          Ignore_msg_if_origin_seen::yes,
+                          actor.pos,
+                          &actor,
+                          Snd_vol::low,
+                          alerts));
+    }
+}
+
+//Counts down all cells of one gas field, returns true if any gas is left. The
+//loop is branch free over a flat array, so that the compiler can vectorize it.
+bool decay(uint8_t field[MAP_W][MAP_H], bool& is_any_cell_cleared)
+{
+    uint8_t* const cells = &field[0][0];
+
+    uint8_t any     = 0;
+    uint8_t cleared = 0;
+
+    for (int i = 0; i < NR_MAP_CELLS; ++i)
+    {
+        cleared |= (cells[i] == 1);
+
+        const uint8_t v = cells[i] - (cells[i] > 0);
+
+        cells[i] = v;
+
+        any |= v;
+    }
+
+    is_any_cell_cleared = cleared != 0;
+
+    return any != 0;
+}
+
+} //namespace
+
+void reset()
+{
+    std::fill_n(&turns_left_[0][0][0], sizeof(turns_left_), 0);
+
+    is_any_gas_ = false;
+}
+
+void add(const Gas_id id, const P& p, const int NR_TURNS)
+{
+    ASSERT(id != Gas_id::END);
+    ASSERT(map::is_pos_inside_map(p));
+
+    if (NR_TURNS <= 0)
+    {
+        return;
+    }
+
+    uint8_t& v = turns_left_[size_t(id)][p.x][p.y];
+
+    //Stored line of sight results must be discarded when gas appears in a cell
+    if (v == 0 && is_los_blocking(id))
+    {
+        fov::on_los_changed();
+    }
+
+    v = uint8_t(std::max(int(v), std::min(NR_TURNS, 255)));
+
+    is_any_gas_ = true;
+}
+
+int nr_turns_left(const Gas_id id, const P& p)
+{
+    return turns_left_[size_t(id)][p.x][p.y];
+}
+
+bool has_gas(const Gas_id id, const P& p)
+{
+    return turns_left_[size_t(id)][p.x][p.y] > 0;
+}
+
+bool blocks_los(const P& p)
+{
+    //Smoke is currently the only gas, and it blocks vision
+    return has_gas(Gas_id::smoke, p);
+}
+
+bool is_any_gas()
+{
+    return is_any_gas_;
+}
+
+void on_new_turn()
+{
+    if (!is_any_gas_)
+    {
+        return;
+    }
+
+    PROFILE_ZONE("gas::on_new_turn");
+
+    //Only the actors need to be checked for effects, not every gas cell
+    for (Actor* const actor : game_time::actors)
+    {
+        if (actor->is_alive() && has_gas(Gas_id::smoke, actor->pos))
+        {
+            run_smoke_effects(*actor);
+        }
+    }
+
+    is_any_gas_ = false;
+
+    for (size_t i = 0; i < size_t(Gas_id::END); ++i)
+    {
+        bool is_any_cell_cleared = false;
+
+        if (decay(turns_left_[i], is_any_cell_cleared))
+        {
+            is_any_gas_ = true;
+        }
+
+        //...or disappears from a cell
+        if (is_any_cell_cleared && is_los_blocking(Gas_id(i)))
+        {
+            fov::on_los_changed();
+        }
+    }
+}
+
+} //gas
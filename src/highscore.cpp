@@ -13,6 +13,10 @@
 #include "popup.hpp"
 #include "input.hpp"
 #include "render.hpp"
+#include "game_time.hpp"
+#include "actor_data.hpp"
+#include "config.hpp"
+#include "run_log.hpp"
 
 Highscore_entry::Highscore_entry(std::string entry_date_and_time,
                                  std::string player_name,
@@ -52,6 +56,19 @@ namespace
 //Set at game over
 Highscore_entry* final_score_ = nullptr;
 
+//Set when the player dies
+std::string death_cause_ = "";
+std::string killer_name_ = "";
+
+//Turn and number of kills when the current run started (the bot starts new
+//runs without starting a new session)
+int run_start_turn_     = 0;
+int run_start_nr_kills_ = 0;
+
+//Highscore file used before the run log, imported into the run log if it does
+//not exist yet
+const std::string old_file_path = "data/highscores";
+
 const int X_POS_DATE    = 0;
 const int X_POS_NAME    = X_POS_DATE  + 19;
 const int X_POS_LVL     = X_POS_NAME  + PLAYER_NAME_MAX_LEN + 2;
@@ -60,68 +77,81 @@ const int X_POS_INS     = X_POS_DLVL  + 7;
 const int X_POS_WIN     = X_POS_INS   + 10;
 const int X_POS_SCORE   = X_POS_WIN   + 5;
 
-void sort_entries(std::vector<Highscore_entry>& entries)
+int nr_kills_tot()
 {
-    auto cmp = [](const Highscore_entry & e1, const Highscore_entry & e2)
+    int nr_kills = 0;
+
+    for (const auto& d : actor_data::data)
     {
-        return e1.score() > e2.score();
-    };
+        if (d.id != Actor_id::player)
+        {
+            nr_kills += d.nr_kills;
+        }
+    }
 
-    sort(entries.begin(), entries.end(), cmp);
+    return nr_kills;
 }
 
-void write_file(std::vector<Highscore_entry>& entries)
+std::string dmg_type_death_cause(const Dmg_type dmg_type)
 {
-    std::ofstream file;
-    file.open("data/highscores", std::ios::trunc);
-
-    for (const auto entry : entries)
+    switch (dmg_type)
     {
-        const std::string WIN_STR = entry.is_win() ? "W" : "0";
-
-        file << WIN_STR                 << std::endl;
-        file << entry.date_and_time()   << std::endl;
-        file << entry.name()            << std::endl;
-        file << entry.xp()              << std::endl;
-        file << entry.lvl()             << std::endl;
-        file << entry.dlvl()            << std::endl;
-        file << entry.ins()             << std::endl;
-        file << int(entry.bg())         << std::endl;
+    case Dmg_type::physical:    return "physical damage";
+    case Dmg_type::fire:        return "fire";
+    case Dmg_type::acid:        return "acid";
+    case Dmg_type::electric:    return "electricity";
+    case Dmg_type::spirit:      return "spirit drained";
+    case Dmg_type::light:       return "light";
+    case Dmg_type::pure:        return "pure damage";
+    case Dmg_type::END:         break;
     }
+
+    return "";
 }
 
-void read_file(std::vector<Highscore_entry>& entries)
+Run_record mk_record(const Highscore_entry& entry)
 {
-    std::ifstream file;
-    file.open("data/highscores");
+    Run_record record;
 
-    if (file.is_open())
-    {
-        std::string line = "";
+    run_log::set_str(record.date_and_time,  entry.date_and_time());
+    run_log::set_str(record.name,           entry.name());
 
-        while (getline(file, line))
-        {
-            bool is_win                     = line[0] == 'W';
-            getline(file, line);
-            const std::string date_and_time = line;
-            getline(file, line);
-            const std::string name          = line;
-            getline(file, line);
-            const int XP                    = to_int(line);
-            getline(file, line);
-            const int LVL                   = to_int(line);
-            getline(file, line);
-            const int DLVL                  = to_int(line);
-            getline(file, line);
-            const int INS                   = to_int(line);
-            getline(file, line);
-            Bg bg                           = Bg(to_int(line));
+    record.score    = entry.score();
+    record.xp       = entry.xp();
+    record.lvl      = entry.lvl();
+    record.dlvl     = entry.dlvl();
+    record.ins      = entry.ins();
+    record.is_win   = entry.is_win();
+    record.bg       = int32_t(entry.bg());
 
-            entries.push_back({date_and_time, name, XP, LVL, DLVL, INS, is_win, bg});
-        }
+    return record;
+}
 
-        file.close();
-    }
+//Makes a record of the current run, with the statistics since the run started
+Run_record mk_cur_run_record(const Highscore_entry& entry)
+{
+    Run_record record = mk_record(entry);
+
+    run_log::set_str(record.death_cause, death_cause_);
+    run_log::set_str(record.killer_name, killer_name_);
+
+    record.is_bot   = config::is_bot_playing();
+    record.nr_turns = game_time::turn() - run_start_turn_;
+    record.nr_kills = nr_kills_tot() - run_start_nr_kills_;
+
+    return record;
+}
+
+Highscore_entry mk_entry(const Run_record& record)
+{
+    return Highscore_entry(record.date_and_time,
+                           record.name,
+                           record.xp,
+                           record.lvl,
+                           record.dlvl,
+                           record.ins,
+                           record.is_win,
+                           Bg(record.bg));
 }
 
 void draw(const std::vector<Highscore_entry>& entries, const int TOP_ELEMENT)
@@ -187,7 +217,13 @@ void draw(const std::vector<Highscore_entry>& entries, const int TOP_ELEMENT)
 
 void init()
 {
-    final_score_ = nullptr;
+    final_score_        = nullptr;
+
+    death_cause_        = "";
+    killer_name_        = "";
+
+    run_start_turn_     = 0;
+    run_start_nr_kills_ = 0;
 }
 
 void cleanup()
@@ -197,10 +233,52 @@ void cleanup()
     final_score_ = nullptr;
 }
 
+void import_old_file()
+{
+    if (run_log::nr_records() > 0)
+    {
+        return;
+    }
+
+    std::ifstream file;
+    file.open(old_file_path);
+
+    if (file.is_open())
+    {
+        TRACE << "Importing " << old_file_path << " into the run log" << std::endl;
+
+        std::string line = "";
+
+        while (getline(file, line))
+        {
+            bool is_win                     = line[0] == 'W';
+            getline(file, line);
+            const std::string date_and_time = line;
+            getline(file, line);
+            const std::string name          = line;
+            getline(file, line);
+            const int XP                    = to_int(line);
+            getline(file, line);
+            const int LVL                   = to_int(line);
+            getline(file, line);
+            const int DLVL                  = to_int(line);
+            getline(file, line);
+            const int INS                   = to_int(line);
+            getline(file, line);
+            Bg bg                           = Bg(to_int(line));
+
+            const Highscore_entry entry(date_and_time, name, XP, LVL, DLVL, INS, is_win, bg);
+
+            run_log::append(mk_record(entry));
+        }
+
+        file.close();
+    }
+}
+
 void run_highscore_screen()
 {
-    std::vector<Highscore_entry> entries;
-    read_file(entries);
+    const std::vector<Highscore_entry> entries = entries_sorted();
 
     if (entries.empty())
     {
@@ -208,8 +286,6 @@ void run_highscore_screen()
         return;
     }
 
-    sort_entries(entries);
-
     int top_nr = 0;
     draw(entries, top_nr);
 
@@ -255,10 +331,36 @@ const Highscore_entry* final_score()
     return final_score_;
 }
 
-void on_game_over(const bool IS_WIN)
+void set_death_cause(const std::string& cause)
+{
+    //Only the first cause is kept (the player may be hit again before the
+    //game over is handled)
+    if (!death_cause_.empty())
+    {
+        return;
+    }
+
+    death_cause_ = cause;
+    killer_name_ = "";
+
+    if (!game_time::actors.empty())
+    {
+        const Actor* const actor = game_time::cur_actor();
+
+        if (!actor->is_player())
+        {
+            killer_name_ = actor->name_a();
+        }
+    }
+}
+
+void set_death_cause(const Dmg_type dmg_type)
 {
-    std::vector<Highscore_entry> entries = entries_sorted();
+    set_death_cause(dmg_type_death_cause(dmg_type));
+}
 
+void on_game_over(const bool IS_WIN)
+{
     final_score_ = new Highscore_entry(cur_time().time_str(Time_type::minute, true),
                                        map::player->name_a(),
                                        dungeon_master::xp(),
@@ -268,21 +370,40 @@ void on_game_over(const bool IS_WIN)
                                        IS_WIN,
                                        player_bon::bg());
 
-    entries.push_back(*final_score_);
-
-    sort_entries(entries);
+    run_log::append(mk_cur_run_record(*final_score_));
+}
 
-    write_file(entries);
+void on_bot_run_done()
+{
+    const Highscore_entry entry(cur_time().time_str(Time_type::minute, true),
+                                map::player->name_a(),
+                                dungeon_master::xp(),
+                                dungeon_master::clvl(),
+                                map::dlvl,
+                                map::player->ins(),
+                                false,
+                                player_bon::bg());
+
+    run_log::append(mk_cur_run_record(entry));
+
+    //The next run starts now
+    death_cause_        = "";
+    killer_name_        = "";
+
+    run_start_turn_     = game_time::turn();
+    run_start_nr_kills_ = nr_kills_tot();
 }
 
 std::vector<Highscore_entry> entries_sorted()
 {
+    std::vector<Run_record> records;
+    run_log::read_top(records);
+
     std::vector<Highscore_entry> entries;
-    read_file(entries);
 
-    if (!entries.empty())
+    for (const Run_record& record : records)
     {
-        sort_entries(entries);
+        entries.push_back(mk_entry(record));
     }
 
     return entries;
@@ -17,7 +17,6 @@
 #include "msg_log.hpp"
 #include "dungeon_master.hpp"
 #include "bot.hpp"
-#include "manual.hpp"
 #include "player_spells_handling.hpp"
 #include "map_templates.hpp"
 #include "map_travel.hpp"
@@ -26,6 +25,10 @@
 #include "save_handling.hpp"
 #include "insanity.hpp"
 #include "highscore.hpp"
+#include "thread_pool.hpp"
+#include "profiler.hpp"
+#include "populate_monsters.hpp"
+#include "populate_items.hpp"
 
 namespace init
 {
@@ -58,28 +61,39 @@ void cleanup_io()
 void init_game()
 {
     TRACE_FUNC_BEGIN;
+#ifdef PROFILING
+    profiler::init();
+#endif //PROFILING
+    actor_data::init();
+    feature_data::init();
+    prop_data::init();
+    item_data::init();
+    populate_mon::init();
+    populate_items::init();
     save_handling::init();
     line_calc::init();
     gods::init();
-    manual::init();
     map_templ_handling::init();
+    thread_pool::init();
     TRACE_FUNC_END;
 }
 
 void cleanup_game()
 {
     TRACE_FUNC_BEGIN;
-
+    thread_pool::cleanup();
+    item_data::cleanup();
+#ifdef PROFILING
+    profiler::cleanup();
+#endif //PROFILING
     TRACE_FUNC_END;
 }
 
 void init_session()
 {
     TRACE_FUNC_BEGIN;
-    actor_data::init();
-    feature_data::init();
-    prop_data::init();
-    item_data::init();
+    actor_data::init_session();
+    item_data::init_session();
     scroll_handling::init();
     potion_handling::init();
     rod_handling::init();
@@ -106,7 +120,6 @@ void cleanup_session()
     insanity::cleanup();
     map::cleanup();
     game_time::cleanup();
-    item_data::cleanup();
     TRACE_FUNC_END;
 }
 
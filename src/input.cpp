@@ -710,7 +710,7 @@ void handle_map_mode_key_press(const Key_data& d)
                         {
                             for (int y = expl_area.p0.y; y <= expl_area.p1.y; ++y)
                             {
-                                Cell& cell = map::cells[x][y];
+                                Cell cell = map::cells[x][y];
 
                                 //Add overlay in this cell if explored OR seen
                                 //NOTE: Cells can be seen without being
@@ -122,6 +122,18 @@ Item_data_t data[int(Item_id::END)];
 namespace
 {
 
+//The parts of the item data which are modified during a game (the names and
+//colors of unidentified items are randomized by each item type's handling)
+struct Session_data
+{
+    bool is_identified;
+    bool is_tried;
+    bool allow_spawn;
+};
+
+//Initial values of the session data, stored when the data list is built
+Session_data session_data_start_[size_t(Item_id::END)];
+
 void add_feature_found_in(Item_data_t& data,
                           const Feature_id feature_id,
                           const int CHANCE_TO_INCL = 100)
@@ -2079,6 +2091,16 @@ void init()
 
     init_data_list();
 
+    for (size_t i = 0; i < size_t(Item_id::END); ++i)
+    {
+        const Item_data_t&  d       = data[i];
+        Session_data&       start   = session_data_start_[i];
+
+        start.is_identified = d.is_identified;
+        start.is_tried      = d.is_tried;
+        start.allow_spawn   = d.allow_spawn;
+    }
+
     TRACE_FUNC_END;
 }
 
@@ -2100,6 +2122,18 @@ void cleanup()
     TRACE_FUNC_END;
 }
 
+void init_session()
+{
+    for (size_t i = 0; i < size_t(Item_id::END); ++i)
+    {
+        Item_data_t&        d       = data[i];
+        const Session_data& start   = session_data_start_[i];
+
+        d.is_identified = start.is_identified;
+        d.is_tried      = start.is_tried;
+        d.allow_spawn   = start.allow_spawn;
+    }
+}
 
 void save()
 {
@@ -528,7 +528,7 @@ void Potion_clairv::quaff_impl(Actor& actor)
         {
             for (int y = 0; y < MAP_H; ++y)
             {
-                Cell& cell = map::cells[x][y];
+                Cell cell = map::cells[x][y];
 
                 if (!blocked[x][y] && !cell.is_dark)
                 {
@@ -15,6 +15,7 @@
 #include "feature_rigid.hpp"
 #include "feature_trap.hpp"
 #include "feature_mob.hpp"
+#include "highscore.hpp"
 
 namespace knock_back
 {
@@ -118,6 +119,7 @@ void try_knock_back(Actor& defender,
             new Prop_paralyzed(Prop_turns::specific, 1));
 
         defender.pos = new_pos;
+        map::invalidate_actor_index();
 
         render::draw_map_state();
         sdl_wrapper::sleep(config::delay_projectile_draw());
@@ -137,6 +139,11 @@ void try_knock_back(Actor& defender,
                              clr_msg_good);
             }
 
+            if (IS_DEFENDER_PLAYER)
+            {
+                highscore::set_death_cause("fell into the depths");
+            }
+
             defender.die(true, false, false);
 
             TRACE_FUNC_END;
@@ -17,6 +17,7 @@
 #include "render.hpp"
 #include "feature_mob.hpp"
 #include "feature_rigid.hpp"
+#include "gas.hpp"
 
 namespace auto_descr_actor
 {
@@ -205,6 +206,12 @@ void print_location_info_msgs(const P& pos)
 
         msg_log::add(str + ".");
 
+        //Describe gas.
+        if (gas::has_gas(Gas_id::smoke, pos))
+        {
+            msg_log::add("Smoke.");
+        }
+
         //Describe mobile features.
         for (auto* mob : game_time::mobs)
         {
@@ -33,6 +33,8 @@ int main(int argc, char* argv[])
     init::init_io();
     init::init_game();
 
+    highscore::import_old_file();
+
     bool quit_game = false;
 
     while (!quit_game)
@@ -130,9 +132,11 @@ int main(int argc, char* argv[])
                     }
                     else //Actor cannot act
                     {
+                        //Turns where the player cannot act are fast-forwarded
+                        //(until a message, or until the player can act again)
                         if (actor->is_player())
                         {
-                            sdl_wrapper::sleep(MS_DELAY_PLAYER_UNABLE_ACT);
+                            render::set_fast_forward(true);
                         }
 
                         game_time::tick();
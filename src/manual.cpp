@@ -15,73 +15,116 @@ namespace manual
 namespace
 {
 
-std::vector<std::string> lines_;
+//The whole file is read the first time the manual is opened, and the lines
+//are wrapped as they are scrolled into view. Each line is a range of text_.
+std::string                         text_;
+std::vector<text_format::Text_span> lines_;
 
-void read_file()
+bool    is_loaded_      = false;
+
+//Start of the first source line not wrapped yet
+size_t  next_src_pos_   = 0;
+
+void load()
 {
-    std::string cur_line;
-    std::ifstream file("manual.txt");
+    if (is_loaded_)
+    {
+        return;
+    }
+
+    is_loaded_ = true;
+
+    std::ifstream file("manual.txt", std::ios::binary);
 
     if (!file.is_open())
     {
         return;
     }
 
-    std::vector<std::string> formatted;
+    file.seekg(0, std::ios::end);
 
-    while (getline(file, cur_line))
+    const std::streamoff SIZE = file.tellg();
+
+    if (SIZE <= 0)
     {
-        if (cur_line.empty())
-        {
-            lines_.push_back(cur_line);
-        }
-        else //Current line not empty
-        {
-            //Do not format lines that start with two spaces
-            bool should_format_line = true;
+        return;
+    }
 
-            if (cur_line.size() >= 2)
-            {
-                if (cur_line[0] == ' ' && cur_line[1] == ' ')
-                {
-                    should_format_line = false;
-                }
-            }
+    text_.resize(size_t(SIZE));
 
-            if (should_format_line)
-            {
-                text_format::split(cur_line, MAP_W, formatted);
+    file.seekg(0, std::ios::beg);
+    file.read(&text_[0], SIZE);
 
-                for (const auto& line : formatted)
-                {
-                    lines_.push_back(line);
-                }
-            }
-            else //Do not format line
-            {
-                lines_.push_back(cur_line);
-            }
-        }
-    }
+    text_.resize(size_t(file.gcount()));
 
     file.close();
 }
 
-} //namespace
+bool is_all_wrapped()
+{
+    return next_src_pos_ >= text_.size();
+}
+
+void wrap_next_src_line()
+{
+    const size_t BEGIN = next_src_pos_;
+
+    size_t end = text_.find('\n', BEGIN);
+
+    if (end == std::string::npos)
+    {
+        end = text_.size();
+    }
+
+    next_src_pos_ = end + 1;
+
+    //The file is read in binary mode, so Windows line endings are left in
+    if (end > BEGIN && text_[end - 1] == '\r')
+    {
+        --end;
+    }
+
+    const size_t LEN = end - BEGIN;
+
+    //Do not format empty lines, or lines that start with two spaces
+    if (LEN == 0 || (LEN >= 2 && text_[BEGIN] == ' ' && text_[BEGIN + 1] == ' '))
+    {
+        lines_.push_back({BEGIN, LEN});
+        return;
+    }
+
+    std::vector<text_format::Text_span> formatted;
+
+    text_format::split_spans(text_.substr(BEGIN, LEN), MAP_W, formatted);
+
+    for (const auto& span : formatted)
+    {
+        lines_.push_back({BEGIN + span.begin, span.len});
+    }
+}
 
-void init()
+//Wraps source lines until there are at least the given number of lines (or all
+//the text is wrapped)
+void wrap_until(const int NR_LINES)
 {
-    read_file();
+    while (int(lines_.size()) < NR_LINES && !is_all_wrapped())
+    {
+        wrap_next_src_line();
+    }
 }
 
+} //namespace
+
 void run()
 {
+    load();
+
     const int LINE_JUMP           = 3;
-    const int NR_LINES_TOT        = lines_.size();
     const int MAX_NR_LINES_ON_SCR = SCREEN_H - 2;
 
     int top_nr = 0;
-    int btm_nr = std::min(top_nr + MAX_NR_LINES_ON_SCR - 1, NR_LINES_TOT - 1);
+
+    wrap_until(top_nr + MAX_NR_LINES_ON_SCR);
 
     while (true)
     {
@@ -90,11 +133,15 @@ void run()
         render::draw_info_scr_interface("Browsing manual",
                                         Inf_screen_type::scrolling);
 
+        const int BTM_NR = std::min(top_nr + MAX_NR_LINES_ON_SCR, int(lines_.size())) - 1;
+
         int y_pos = 1;
 
-        for (int i = top_nr; i <= btm_nr; ++i)
+        for (int i = top_nr; i <= BTM_NR; ++i)
         {
-            render::draw_text(lines_[i],
+            const auto& line = lines_[i];
+
+            render::draw_text(text_.substr(line.begin, line.len),
                               Panel::screen,
                               P(0, y_pos++),
                               clr_text);
@@ -108,13 +155,19 @@ void run()
         {
             top_nr += LINE_JUMP;
 
-            if (NR_LINES_TOT <= MAX_NR_LINES_ON_SCR)
+            //If the text runs out before a full screen below the new top, the
+            //number of lines is now known, and the top is limited by it
+            wrap_until(top_nr + MAX_NR_LINES_ON_SCR);
+
+            const int NR_LINES = lines_.size();
+
+            if (NR_LINES <= MAX_NR_LINES_ON_SCR)
             {
                 top_nr = 0;
             }
             else
             {
-                top_nr = std::min(NR_LINES_TOT - MAX_NR_LINES_ON_SCR, top_nr);
+                top_nr = std::min(NR_LINES - MAX_NR_LINES_ON_SCR, top_nr);
             }
         }
         else if (d.key == '8' || d.sdl_key == SDLK_UP || d.key == 'k')
@@ -125,8 +178,6 @@ void run()
         {
             break;
         }
-
-        btm_nr = std::min(top_nr + MAX_NR_LINES_ON_SCR - 1, NR_LINES_TOT - 1);
     }
 }
 
@@ -14,37 +14,17 @@
 #include "item.hpp"
 #include "feature_rigid.hpp"
 #include "save_handling.hpp"
+#include "fov.hpp"
+#include "gas.hpp"
 
 #ifdef DEMO_MODE
 #include "sdl_wrapper.hpp"
 #endif // DEMO_MODE
 
-Cell::Cell() :
-    is_explored         (false),
-    is_seen_by_player   (false),
-    is_lit              (false),
-    is_dark             (false),
-    player_los          (),
-    item                (nullptr),
-    rigid               (nullptr),
-    player_visual_memory(Cell_render_data()),
-    pos(P(-1, -1)) {}
-
-Cell::~Cell()
-{
-    if (rigid)
-    {
-        delete rigid;
-    }
-
-    if (item)
-    {
-        delete item;
-    }
-}
-
 void Cell::reset()
 {
+    //NOTE: Changing the light or darkness outside of the light map update must
+    //be followed by fov::on_los_changed() (see reset_cells())
     is_explored = is_seen_by_player = is_lit = is_dark = false;
 
     player_los.is_blocked_hard      = true;
@@ -52,14 +32,16 @@ void Cell::reset()
 
     player_visual_memory = Cell_render_data();
 
-    pos.set(-1, -1);
+    Rigid*& rigid_here = map::planes.rigid[pos.x][pos.y];
 
-    if (rigid)
+    if (rigid_here)
     {
-        delete rigid;
-        rigid = nullptr;
+        delete rigid_here;
+        rigid_here = nullptr;
     }
 
+    map::planes.rigid_id[pos.x][pos.y] = Feature_id::END;
+
     if (item)
     {
         delete item;
@@ -72,7 +54,8 @@ namespace map
 
 Player*             player  = nullptr;
 int                 dlvl    = 0;
-Cell                cells[MAP_W][MAP_H];
+Cell_planes         planes;
+const Cell_grid     cells;
 std::vector<Room*>  room_list;
 Room*               room_map[MAP_W][MAP_H];
 Clr                 wall_clr;
@@ -80,14 +63,26 @@ Clr                 wall_clr;
 namespace
 {
 
+std::vector<P>  active_rigids_;
+bool            is_rigid_active_[MAP_W][MAP_H];
+
+Actor*          living_actor_index_[MAP_W][MAP_H];
+std::vector<P>  living_actor_index_positions_; //Set entries, for fast clearing
+bool            is_actor_index_valid_ = false;
+
 void reset_cells(const bool MAKE_STONE_WALLS)
 {
+    active_rigids_.clear();
+
+    gas::reset();
+
     for (int x = 0; x < MAP_W; ++x)
     {
         for (int y = 0; y < MAP_H; ++y)
         {
             cells[x][y].reset();
-            cells[x][y].pos = P(x, y);
+
+            is_rigid_active_[x][y] = false;
 
             room_map[x][y] = nullptr;
 
@@ -100,6 +95,8 @@ void reset_cells(const bool MAKE_STONE_WALLS)
             }
         }
     }
+
+    fov::on_los_changed();
 }
 
 } //namespace
@@ -125,8 +122,9 @@ void cleanup()
     {
         for (int y = 0; y < MAP_H; ++y)
         {
-            delete cells[x][y].rigid;
-            cells[x][y].rigid = nullptr;
+            delete planes.rigid[x][y];
+            planes.rigid[x][y]      = nullptr;
+            planes.rigid_id[x][y]   = Feature_id::END;
         }
     }
 
@@ -191,12 +189,23 @@ Rigid* put(Rigid* const f)
 {
     ASSERT(f);
 
-    const P p     = f->pos();
-    Cell&     cell  = cells[p.x][p.y];
+    const P p = f->pos();
 
-    delete cell.rigid;
+    Rigid*& rigid_here = planes.rigid[p.x][p.y];
 
-    cell.rigid = f;
+    delete rigid_here;
+
+    rigid_here                  = f;
+    planes.rigid_id[p.x][p.y]   = f->id();
+
+    //NOTE: If the replaced rigid was active, the position stays registered
+    //until the next turn (running an inactive rigid does nothing)
+    if (f->is_active())
+    {
+        activate_rigid(p);
+    }
+
+    fov::on_los_changed();
 
 #ifdef DEMO_MODE
 
@@ -221,6 +230,49 @@ Rigid* put(Rigid* const f)
     return f;
 }
 
+void activate_rigid(const P& p)
+{
+    ASSERT(is_pos_inside_map(p));
+
+    bool& is_active = is_rigid_active_[p.x][p.y];
+
+    if (!is_active)
+    {
+        is_active = true;
+        active_rigids_.push_back(p);
+    }
+}
+
+bool is_rigid_active(const P& p)
+{
+    return is_rigid_active_[p.x][p.y];
+}
+
+const std::vector<P>& active_rigids()
+{
+    return active_rigids_;
+}
+
+void remove_inactive_rigids()
+{
+    size_t nr_kept = 0;
+
+    for (const P& p : active_rigids_)
+    {
+        if (planes.rigid[p.x][p.y]->is_active())
+        {
+            active_rigids_[nr_kept] = p;
+            ++nr_kept;
+        }
+        else
+        {
+            is_rigid_active_[p.x][p.y] = false;
+        }
+    }
+
+    active_rigids_.resize(nr_kept);
+}
+
 void cpy_render_array_to_visual_memory()
 {
     for (int x = 0; x < MAP_W; ++x)
@@ -308,6 +360,49 @@ Actor* actor_at_pos(const P& pos, Actor_state state)
     return nullptr;
 }
 
+Actor* living_actor_at_pos_indexed(const P& pos)
+{
+    if (!is_actor_index_valid_)
+    {
+        //Only the previously set entries need to be cleared, so rebuilding the
+        //index costs about the same as one actor_at_pos() call
+        for (const P& p : living_actor_index_positions_)
+        {
+            living_actor_index_[p.x][p.y] = nullptr;
+        }
+
+        living_actor_index_positions_.clear();
+
+        //Iterating backwards, so that the first living actor in the actor list
+        //is indexed (same as for actor_at_pos)
+        for (auto it = game_time::actors.rbegin(); it != game_time::actors.rend(); ++it)
+        {
+            Actor* const actor = *it;
+
+            if (actor->is_alive())
+            {
+                living_actor_index_[actor->pos.x][actor->pos.y] = actor;
+
+                living_actor_index_positions_.push_back(actor->pos);
+            }
+        }
+
+        is_actor_index_valid_ = true;
+    }
+
+    Actor* const actor = living_actor_index_[pos.x][pos.y];
+
+    //If this fails, an actor was moved, added or killed without invalidating
+    ASSERT(actor == actor_at_pos(pos));
+
+    return actor;
+}
+
+void invalidate_actor_index()
+{
+    is_actor_index_valid_ = false;
+}
+
 Mob* first_mob_at_pos(const P& pos)
 {
     for (auto* const mob : game_time::mobs)
@@ -2,13 +2,16 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstdlib>
 
 #include "init.hpp"
+#include "bit_grid.hpp"
 #include "map.hpp"
 #include "actor_player.hpp"
 #include "game_time.hpp"
 #include "feature_rigid.hpp"
 #include "feature_mob.hpp"
+#include "gas.hpp"
 
 //------------------------------------------------------------ CELL CHECKS
 namespace cell_check
@@ -16,7 +19,10 @@ namespace cell_check
 
 bool Blocks_los::check(const Cell& c)  const
 {
-    return !map::is_pos_inside_map(c.pos, false) || !c.rigid->is_los_passable();
+    return
+        !map::is_pos_inside_map(c.pos, false)   ||
+        !c.rigid->is_los_passable()             ||
+        gas::blocks_los(c.pos);
 }
 
 bool Blocks_los::check(const Mob& f) const
@@ -86,14 +92,14 @@ bool Blocks_items::check(const Mob& f) const
 
 bool Is_feature::check(const Cell& c) const
 {
-    return c.rigid->id() == feature_;
+    return c.rigid_id == feature_;
 }
 
 bool Is_any_of_features::check(const Cell& c) const
 {
     for (auto f : features_)
     {
-        if (f == c.rigid->id())
+        if (f == c.rigid_id)
         {
             return true;
         }
@@ -116,7 +122,7 @@ bool All_adj_is_feature::check(const Cell& c) const
     {
         for (int dy = -1; dy <= 1; ++dy)
         {
-            if (map::cells[X + dx][Y + dy].rigid->id() != feature_)
+            if (map::planes.rigid_id[X + dx][Y + dy] != feature_)
             {
                 return false;
             }
@@ -140,7 +146,7 @@ bool All_adj_is_any_of_features::check(const Cell& c) const
     {
         for (int dy = -1; dy <= 1; ++dy)
         {
-            const auto cur_id = map::cells[X + dx][Y + dy].rigid->id();
+            const auto cur_id = map::planes.rigid_id[X + dx][Y + dy];
 
             bool is_match = false;
 
@@ -177,7 +183,7 @@ bool All_adj_is_not_feature::check(const Cell& c) const
     {
         for (int dy = -1; dy <= 1; ++dy)
         {
-            if (map::cells[X + dx][Y + dy].rigid->id() == feature_)
+            if (map::planes.rigid_id[X + dx][Y + dy] == feature_)
             {
                 return false;
             }
@@ -201,7 +207,7 @@ bool All_adj_is_none_of_features::check(const Cell& c) const
     {
         for (int dy = -1; dy <= 1; ++dy)
         {
-            const auto cur_id = map::cells[X + dx][Y + dy].rigid->id();
+            const auto cur_id = map::planes.rigid_id[X + dx][Y + dy];
 
             for (auto f : features_)
             {
@@ -362,46 +368,7 @@ void cells_within_dist_of_others(const bool in[MAP_W][MAP_H], bool out[MAP_W][MA
 {
     ASSERT(in != out);
 
-    for (int x = 0; x < MAP_W; ++x)
-    {
-        for (int y = 0; y < MAP_H; ++y)
-        {
-            out[x][y] = false;
-        }
-    }
-
-    for (int y_outer = 0; y_outer < MAP_H; y_outer++)
-    {
-        for (int x_outer = 0; x_outer < MAP_W; x_outer++)
-        {
-            if (!out[x_outer][y_outer])
-            {
-                for (int d = dist_interval.min; d <= dist_interval.max; d++)
-                {
-                    P p0(std::max(0,         x_outer - d), std::max(0,         y_outer - d));
-                    P p1(std::min(MAP_W - 1, x_outer + d), std::min(MAP_H - 1, y_outer + d));
-
-                    for (int x = p0.x; x <= p1.x; ++x)
-                    {
-                        if (in[x][p0.y] || in[x][p1.y])
-                        {
-                            out[x_outer][y_outer] = true;
-                            break;
-                        }
-                    }
-
-                    for (int y = p0.y; y <= p1.y; ++y)
-                    {
-                        if (in[p0.x][y] || in[p1.x][y])
-                        {
-                            out[x_outer][y_outer] = true;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    Bit_grid(in).dist_band(dist_interval).to_array(out);
 }
 
 void append(bool base[MAP_W][MAP_H], const bool append[MAP_W][MAP_H])
@@ -424,37 +391,13 @@ void expand(const bool in[MAP_W][MAP_H],
     const int X1 = std::min(MAP_W - 1,  area_allowed_to_modify.p1.x);
     const int Y1 = std::min(MAP_H - 1,  area_allowed_to_modify.p1.y);
 
+    const Bit_grid expanded = Bit_grid(in).dilated(1);
+
     for (int x = X0; x <= X1; ++x)
     {
         for (int y = Y0; y <= Y1; ++y)
         {
-            out[x][y] = false;
-
-            //Search all cells adjacent to the current position for any cell
-            //which is "true" in the input arry.
-            const int CMP_X0 = std::max(x - 1, 0);
-            const int CMP_Y0 = std::max(y - 1, 0);
-            const int CMP_X1 = std::min(x + 1, MAP_W - 1);
-            const int CMP_Y1 = std::min(y + 1, MAP_H - 1);
-
-            for (int cmp_x = CMP_X0; cmp_x <= CMP_X1; ++cmp_x)
-            {
-                bool is_found = false;
-
-                for (int cmp_y = CMP_Y0; cmp_y <= CMP_Y1; ++cmp_y)
-                {
-                    if (in[cmp_x][cmp_y])
-                    {
-                        out[x][y] = is_found = true;
-                        break;
-                    }
-                }
-
-                if (is_found)
-                {
-                    break;
-                }
-            }
+            out[x][y] = expanded.at(P(x, y));
         }
     }
 }
@@ -463,42 +406,7 @@ void expand(const bool in[MAP_W][MAP_H],
             bool out[MAP_W][MAP_H],
             const int DIST)
 {
-    for (int x = 0; x < MAP_W; ++x)
-    {
-        for (int y = 0; y < MAP_H; ++y)
-        {
-            out[x][y] = false;
-
-            const int X0 = x - DIST;
-            const int Y0 = y - DIST;
-            const int X1 = x + DIST;
-            const int Y1 = y + DIST;
-
-            const int CMP_X0 = X0 < 0 ? 0 : X0;
-            const int CMP_Y0 = Y0 < 0 ? 0 : Y0;
-            const int CMP_X1 = X1 > MAP_W - 1 ? MAP_W - 1 : X1;
-            const int CMP_Y1 = Y1 > MAP_H - 1 ? MAP_H - 1 : Y1;
-
-            for (int cmp_y = CMP_Y0; cmp_y <= CMP_Y1; ++cmp_y)
-            {
-                bool is_found = false;
-
-                for (int cmp_x = CMP_X0; cmp_x <= CMP_X1; ++cmp_x)
-                {
-                    if (in[cmp_x][cmp_y])
-                    {
-                        is_found = out[x][y] = true;
-                        break;
-                    }
-                }
-
-                if (is_found)
-                {
-                    break;
-                }
-            }
-        }
-    }
+    Bit_grid(in).dilated(DIST).to_array(out);
 }
 
 bool is_map_connected(const bool blocked[MAP_W][MAP_H])
@@ -540,9 +448,8 @@ bool is_map_connected(const bool blocked[MAP_W][MAP_H])
         for (int y = 1; y < MAP_H - 1; ++y)
         {
             if (
-                flood_fill[x][y] == 0   &&
-                !blocked[x][y]          &&
-                P(x, y) != origin)
+                flood_fill[x][y] == flood_fill::unreached &&
+                !blocked[x][y])
             {
                 return false;
             }
@@ -562,118 +469,299 @@ bool Is_closer_to_pos::operator()(const P& p1, const P& p2)
     return king_dist1 < king_dist2;
 }
 
-//------------------------------------------------------------ FLOOD FILL
-namespace flood_fill
+//------------------------------------------------------------ DISTANCE FIELDS
+namespace dist_field
 {
 
-void run(const P& p0,
-         const bool blocked[MAP_W][MAP_H],
-         int out[MAP_W][MAP_H],
-         int travel_lmt,
-         const P& p1,
-         const bool ALLOW_DIAGONAL)
+namespace
 {
-    std::fill_n(*out, NR_MAP_CELLS, 0);
 
-    std::vector<P> positions;
+void relax(int& dist, const int OTHER_DIST)
+{
+    if (OTHER_DIST != unreached && OTHER_DIST + 1 < dist)
+    {
+        dist = OTHER_DIST + 1;
+    }
+}
 
-    unsigned int    nr_elements_to_skip = 0;
-    int             cur_val             = 0;
-    bool            path_exists         = true;
-    bool            is_at_tgt           = false;
-    bool            is_stopping_at_p1   = p1.x != -1;
+} //namespace
 
-    const R bounds(P(1, 1), P(MAP_W - 2, MAP_H - 2));
+void chebyshev(const bool sources[MAP_W][MAP_H], int out[MAP_W][MAP_H])
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            out[x][y] = sources[x][y] ? 0 : unreached;
+        }
+    }
+
+    //Forward sweep - propagate from the cells above and to the left
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            int& dist = out[x][y];
 
-    P cur_pos(p0);
+            if (x > 0)
+            {
+                relax(dist, out[x - 1][y]);
+            }
+
+            if (y > 0)
+            {
+                relax(dist, out[x][y - 1]);
 
-    std::vector<P> dirs
+                if (x > 0)
+                {
+                    relax(dist, out[x - 1][y - 1]);
+                }
+
+                if (x < MAP_W - 1)
+                {
+                    relax(dist, out[x + 1][y - 1]);
+                }
+            }
+        }
+    }
+
+    //Backward sweep - propagate from the cells below and to the right
+    for (int y = MAP_H - 1; y >= 0; --y)
     {
-        P( 0, -1),
-        P(-1,  0),
-        P( 0,  1),
-        P( 1,  0)
-    };
+        for (int x = MAP_W - 1; x >= 0; --x)
+        {
+            int& dist = out[x][y];
 
-    if (ALLOW_DIAGONAL)
+            if (x < MAP_W - 1)
+            {
+                relax(dist, out[x + 1][y]);
+            }
+
+            if (y < MAP_H - 1)
+            {
+                relax(dist, out[x][y + 1]);
+
+                if (x < MAP_W - 1)
+                {
+                    relax(dist, out[x + 1][y + 1]);
+                }
+
+                if (x > 0)
+                {
+                    relax(dist, out[x - 1][y + 1]);
+                }
+            }
+        }
+    }
+}
+
+void chebyshev(const P& source, int out[MAP_W][MAP_H])
+{
+    for (int x = 0; x < MAP_W; ++x)
     {
-        dirs.push_back(P(-1, -1));
-        dirs.push_back(P(-1, 1));
-        dirs.push_back(P(1, -1));
-        dirs.push_back(P(1, 1));
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            out[x][y] = king_dist(source.x, source.y, x, y);
+        }
     }
+}
 
-    bool done = false;
+void sorted_cells(const int dist[MAP_W][MAP_H],
+                  const bool include[MAP_W][MAP_H],
+                  std::vector<P>& out,
+                  const int MAX_DIST)
+{
+    out.clear();
 
-    while (!done)
-    {
+    //Counting sort - first count the number of cells at each distance...
+    int highest_dist = -1;
 
-        for (const P& d : dirs)
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
         {
-            if ((d != 0))
+            const int DIST = dist[x][y];
+
+            if (include[x][y] && DIST <= MAX_DIST)
             {
-                const P new_pos(cur_pos + d);
+                highest_dist = std::max(highest_dist, DIST);
+            }
+        }
+    }
 
-                if (
-                    !blocked[new_pos.x][new_pos.y]  &&
-                    is_pos_inside(new_pos, bounds)  &&
-                    out[new_pos.x][new_pos.y] == 0  &&
-                    new_pos != p0)
-                {
-                    cur_val = out[cur_pos.x][cur_pos.y];
+    if (highest_dist < 0)
+    {
+        return;
+    }
 
-                    if (cur_val < travel_lmt)
-                    {
-                        out[new_pos.x][new_pos.y] = cur_val + 1;
-                    }
+    std::vector<int> offsets(highest_dist + 2, 0);
 
-                    if (is_stopping_at_p1 && cur_pos == p1 - d)
-                    {
-                        is_at_tgt = true;
-                        break;
-                    }
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            const int DIST = dist[x][y];
 
-                    if (!is_stopping_at_p1 || !is_at_tgt)
-                    {
-                        positions.push_back(new_pos);
-                    }
-                }
+            if (include[x][y] && DIST >= 0 && DIST <= highest_dist)
+            {
+                ++offsets[DIST + 1];
             }
         }
+    }
+
+    for (size_t i = 1; i < offsets.size(); ++i)
+    {
+        offsets[i] += offsets[i - 1];
+    }
+
+    //...then put each cell directly at its place
+    out.resize(offsets.back());
 
-        if (is_stopping_at_p1)
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
         {
-            if (positions.size() == nr_elements_to_skip)
+            const int DIST = dist[x][y];
+
+            if (include[x][y] && DIST >= 0 && DIST <= highest_dist)
             {
-                path_exists = false;
+                out[offsets[DIST]++] = P(x, y);
             }
+        }
+    }
+}
+
+void sorted_cells_near(const P& origin,
+                       const bool include[MAP_W][MAP_H],
+                       std::vector<P>& out,
+                       const int MAX_DIST)
+{
+    out.clear();
+
+    const int X0 = std::max(0,          origin.x - MAX_DIST);
+    const int Y0 = std::max(0,          origin.y - MAX_DIST);
+    const int X1 = std::min(MAP_W - 1,  origin.x + MAX_DIST);
+    const int Y1 = std::min(MAP_H - 1,  origin.y + MAX_DIST);
 
-            if (is_at_tgt || !path_exists)
+    std::vector<int> offsets(MAX_DIST + 2, 0);
+
+    for (int x = X0; x <= X1; ++x)
+    {
+        for (int y = Y0; y <= Y1; ++y)
+        {
+            if (include[x][y])
             {
-                done = true;
+                ++offsets[king_dist(origin.x, origin.y, x, y) + 1];
             }
         }
-        else if (positions.size() == nr_elements_to_skip)
+    }
+
+    for (size_t i = 1; i < offsets.size(); ++i)
+    {
+        offsets[i] += offsets[i - 1];
+    }
+
+    out.resize(offsets.back());
+
+    for (int x = X0; x <= X1; ++x)
+    {
+        for (int y = Y0; y <= Y1; ++y)
         {
-            done = true;
+            if (include[x][y])
+            {
+                out[offsets[king_dist(origin.x, origin.y, x, y)]++] = P(x, y);
+            }
         }
+    }
+}
+
+} //dist_field
+
+//------------------------------------------------------------ FLOOD FILL
+namespace flood_fill
+{
+
+namespace
+{
+
+//Frontier storage reused between calls. Each cell is queued at most once, so
+//the ring buffer can never hold more than all map cells.
+const size_t frontier_size_ = 2048;
+
+static_assert(frontier_size_ >= size_t(NR_MAP_CELLS),
+              "Flood fill frontier must fit all map cells");
+
+thread_local P frontier_[frontier_size_];
+
+} //namespace
+
+void run(const P& p0,
+         const bool blocked[MAP_W][MAP_H],
+         int out[MAP_W][MAP_H],
+         int travel_lmt,
+         const P& p1,
+         const bool ALLOW_DIAGONAL)
+{
+    std::fill_n(*out, NR_MAP_CELLS, unreached);
+
+    out[p0.x][p0.y] = 0;
+
+    const bool IS_STOPPING_AT_P1 = p1.x != -1;
+
+    if (IS_STOPPING_AT_P1 && p0 == p1)
+    {
+        return;
+    }
+
+    const R bounds(P(1, 1), P(MAP_W - 2, MAP_H - 2));
+
+    const std::vector<P>& dirs = ALLOW_DIAGONAL ?
+                                 dir_utils::dir_list :
+                                 dir_utils::cardinal_list;
+
+    //Blocked and already visited cells are kept in the same grid, so only one
+    //bit needs to be checked per neighbour
+    Bit_grid closed(blocked);
+
+    closed.set(p0);
 
-        if (cur_val == travel_lmt)
+    size_t head = 0;
+    size_t tail = 0;
+
+    frontier_[tail++ % frontier_size_] = p0;
+
+    while (head != tail)
+    {
+        const P p = frontier_[head++ % frontier_size_];
+
+        const int DIST = out[p.x][p.y];
+
+        //The frontier is visited in order of distance, so all remaining cells
+        //are at the travel limit as well
+        if (DIST >= travel_lmt)
         {
-            done = true;
+            break;
         }
 
-        if (!is_stopping_at_p1 || !is_at_tgt)
+        for (const P& d : dirs)
         {
-            if (positions.size() == nr_elements_to_skip)
+            const P new_p(p + d);
+
+            if (!is_pos_inside(new_p, bounds) || closed.at(new_p))
             {
-                path_exists = false;
+                continue;
             }
-            else
+
+            closed.set(new_p);
+
+            out[new_p.x][new_p.y] = DIST + 1;
+
+            if (IS_STOPPING_AT_P1 && new_p == p1)
             {
-                cur_pos = positions[nr_elements_to_skip];
-                nr_elements_to_skip++;
+                return;
             }
+
+            frontier_[tail++ % frontier_size_] = new_p;
         }
     }
 }
@@ -702,7 +790,7 @@ void run(const P& p0,
     int flood[MAP_W][MAP_H];
     flood_fill::run(p0, blocked, flood, 10000, p1, ALLOW_DIAGONAL);
 
-    if (flood[p1.x][p1.y] == 0)
+    if (flood[p1.x][p1.y] == flood_fill::unreached)
     {
         //No path exists
         return;
@@ -742,11 +830,13 @@ void run(const P& p0,
 
             const bool IS_INSIDE_MAP = map::is_pos_inside_map(adj_pos);
 
-            const int VAL_AT_ADJ = IS_INSIDE_MAP ? flood[adj_pos.x][adj_pos.y] : 0;
+            const int VAL_AT_ADJ = IS_INSIDE_MAP ?
+                                   flood[adj_pos.x][adj_pos.y] :
+                                   flood_fill::unreached;
 
             const int VAL_AT_CUR = flood[cur_pos.x][cur_pos.y];
 
-            valid_offsets[i] = VAL_AT_ADJ < VAL_AT_CUR && VAL_AT_ADJ != 0;
+            valid_offsets[i] = VAL_AT_ADJ < VAL_AT_CUR;
         }
 
         //Set the adjacent position to one of the valid offset
@@ -788,3 +878,224 @@ void run(const P& p0,
 
 } //path_find
 
+//------------------------------------------------------------ A*
+namespace a_star
+{
+
+namespace
+{
+
+struct Node
+{
+    Node(const int f, const int g, const P& p) :
+        f(f),
+        g(g),
+        p(p) {}
+
+    int f; //Cost so far plus estimated remaining cost
+    int g; //Cost so far
+    P   p;
+};
+
+//Orders the heap with the lowest estimated total cost on top. On ties, nodes
+//which have come further are preferred (they are likely closer to the target).
+bool is_worse(const Node& n1, const Node& n2)
+{
+    return n1.f > n2.f || (n1.f == n2.f && n1.g < n2.g);
+}
+
+//Search state reused between calls. Values are only valid for cells stamped
+//with the current search number, so nothing needs to be cleared per search.
+thread_local std::vector<Node>  open_;
+thread_local int                g_              [MAP_W][MAP_H];
+thread_local int                dir_idx_        [MAP_W][MAP_H];
+thread_local unsigned int       open_stamp_     [MAP_W][MAP_H];
+thread_local unsigned int       closed_stamp_   [MAP_W][MAP_H];
+thread_local unsigned int       cur_stamp_      = 0;
+
+void start_new_search()
+{
+    ++cur_stamp_;
+
+    if (cur_stamp_ == 0)
+    {
+        //Stamp counter wrapped around - old stamps could look valid
+        std::fill_n(*open_stamp_,   NR_MAP_CELLS, 0);
+        std::fill_n(*closed_stamp_, NR_MAP_CELLS, 0);
+
+        cur_stamp_ = 1;
+    }
+
+    open_.clear();
+}
+
+//The octile distance, assuming diagonal steps cost the same as cardinal steps
+//(as they do for actors) - i.e. the Chebyshev distance. This never over
+//estimates, since each step costs at least one.
+int heuristic(const P& p, const P& tgt, const bool ALLOW_DIAGONAL)
+{
+    const int DX = std::abs(tgt.x - p.x);
+    const int DY = std::abs(tgt.y - p.y);
+
+    return ALLOW_DIAGONAL ? std::max(DX, DY) : (DX + DY);
+}
+
+//Walks back from a searched cell to the origin, following the stored directions
+void mk_path(const P& p0, const P& p, const std::vector<P>& dirs, std::vector<P>& out)
+{
+    P path_p(p);
+
+    while (path_p != p0)
+    {
+        out.push_back(path_p);
+
+        path_p = path_p - dirs[dir_idx_[path_p.x][path_p.y]];
+    }
+}
+
+} //namespace
+
+bool run(const P& p0,
+         const P& p1,
+         const int cost[MAP_W][MAP_H],
+         std::vector<P>& out,
+         const bool ALLOW_DIAGONAL,
+         const int MAX_NR_EXPANSIONS,
+         const bool ALLOW_PARTIAL_PATH)
+{
+    out.clear();
+
+    const R bounds(P(1, 1), P(MAP_W - 2, MAP_H - 2));
+
+    if (p0 == p1 || !is_pos_inside(p1, bounds) || cost[p1.x][p1.y] <= 0)
+    {
+        return true;
+    }
+
+    const std::vector<P>& dirs = ALLOW_DIAGONAL ?
+                                 dir_utils::dir_list :
+                                 dir_utils::cardinal_list;
+
+    start_new_search();
+
+    g_          [p0.x][p0.y] = 0;
+    open_stamp_ [p0.x][p0.y] = cur_stamp_;
+
+    open_.push_back(Node(heuristic(p0, p1, ALLOW_DIAGONAL), 0, p0));
+
+    int nr_expansions = 0;
+
+    //The expanded cell closest to the target (used for partial paths)
+    P   best_p(p0);
+    int best_h = heuristic(p0, p1, ALLOW_DIAGONAL);
+    int best_g = 0;
+
+    while (!open_.empty())
+    {
+        std::pop_heap(begin(open_), end(open_), is_worse);
+
+        const Node node = open_.back();
+
+        open_.pop_back();
+
+        const P& p = node.p;
+
+        //Cells may be pushed several times if a cheaper way is found - only the
+        //first (cheapest) one is expanded
+        if (closed_stamp_[p.x][p.y] == cur_stamp_)
+        {
+            continue;
+        }
+
+        closed_stamp_[p.x][p.y] = cur_stamp_;
+
+        if (p == p1)
+        {
+            mk_path(p0, p1, dirs, out);
+
+            return true;
+        }
+
+        const int H = heuristic(p, p1, ALLOW_DIAGONAL);
+
+        if (H < best_h || (H == best_h && node.g < best_g))
+        {
+            best_p = p;
+            best_h = H;
+            best_g = node.g;
+        }
+
+        ++nr_expansions;
+
+        if (nr_expansions > MAX_NR_EXPANSIONS)
+        {
+            TRACE_VERBOSE << "A* expansion limit reached" << std::endl;
+
+            if (ALLOW_PARTIAL_PATH)
+            {
+                mk_path(p0, best_p, dirs, out);
+            }
+
+            return false;
+        }
+
+        for (size_t i = 0; i < dirs.size(); ++i)
+        {
+            const P new_p(p + dirs[i]);
+
+            if (
+                !is_pos_inside(new_p, bounds) ||
+                closed_stamp_[new_p.x][new_p.y] == cur_stamp_)
+            {
+                continue;
+            }
+
+            const int STEP_COST = cost[new_p.x][new_p.y];
+
+            if (STEP_COST <= 0)
+            {
+                continue;
+            }
+
+            const int NEW_G = node.g + STEP_COST;
+
+            if (open_stamp_[new_p.x][new_p.y] != cur_stamp_ || NEW_G < g_[new_p.x][new_p.y])
+            {
+                open_stamp_ [new_p.x][new_p.y] = cur_stamp_;
+                g_          [new_p.x][new_p.y] = NEW_G;
+                dir_idx_    [new_p.x][new_p.y] = i;
+
+                open_.push_back(Node(NEW_G + heuristic(new_p, p1, ALLOW_DIAGONAL),
+                                     NEW_G,
+                                     new_p));
+
+                std::push_heap(begin(open_), end(open_), is_worse);
+            }
+        }
+    }
+
+    //No path exists
+    return true;
+}
+
+bool run(const P& p0,
+         const P& p1,
+         const bool blocked[MAP_W][MAP_H],
+         std::vector<P>& out,
+         const bool ALLOW_DIAGONAL,
+         const int MAX_NR_EXPANSIONS)
+{
+    int cost[MAP_W][MAP_H];
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            cost[x][y] = blocked[x][y] ? 0 : 1;
+        }
+    }
+
+    return run(p0, p1, cost, out, ALLOW_DIAGONAL, MAX_NR_EXPANSIONS);
+}
+
+} //a_star
@@ -1,9 +1,51 @@
 #include "map_templates.hpp"
 
 #include "init.hpp"
-#include "game_time.hpp"
 
-#include <vector>
+#include <cstring>
+
+Map_templ::Map_templ() :
+    rows_   (nullptr),
+    dims_   (0, 0) {}
+
+Map_templ::Map_templ(const char* const rows,
+                     const P& dims,
+                     const Map_templ_cell* const palette,
+                     const size_t NR_PALETTE_CELLS) :
+    rows_   (rows),
+    dims_   (dims)
+{
+    for (size_t i = 0; i < NR_PALETTE_CELLS; ++i)
+    {
+        const Map_templ_cell& palette_cell = palette[i];
+
+        palette_[(unsigned char)palette_cell.ch] = palette_cell;
+    }
+
+#ifndef NDEBUG
+    for (int y = 0; y < dims_.y; ++y)
+    {
+        const char* const row = rows_ + (y * (dims_.x + 1));
+
+        if (int(strlen(row)) != dims_.x)
+        {
+            TRACE << "Bad map template row length at row: " << y << std::endl;
+            ASSERT(false);
+        }
+
+        for (int x = 0; x < dims_.x; ++x)
+        {
+            const char CH = row[x];
+
+            if (CH != ' ' && palette_[(unsigned char)CH].ch != CH)
+            {
+                TRACE << "No map template cell for char: " << CH << std::endl;
+                ASSERT(false);
+            }
+        }
+    }
+#endif // NDEBUG
+}
 
 namespace map_templ_handling
 {
@@ -13,350 +55,329 @@ namespace
 
 Map_templ templates_[size_t(Map_templ_id::END)];
 
-Map_templ_cell ch_to_cell(const char CH,
-                          const std::vector<Map_templ_cell>& prototypes)
+//Blank level with correct dimensions to copy/paste when making new templates.
+//Each character is mapped to a cell by the palette of the template, space is
+//an empty cell.
+//  "################################################################################",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "#..............................................................................#",
+//  "################################################################################",
+
+//Filled version
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################",
+//  "################################################################################"
+
+//----------------------------------------------------------------- FOREST
+const char forest_rows[][MAP_W + 1] =
 {
-    for (const Map_templ_cell& proto : prototypes)
-    {
-        if (proto.ch == CH)
-        {
-            return proto;
-        }
-    }
+    "tttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttt",
+    "tttttttttttttttttt,,,,,,,,,,tttttttt~~~~~~~~tttttttttt,,,tt,t,,t,,ttt,,ttttttttt",
+    "tttt,=,,,,ttttttt,,,,,t,,,,tttt~,~,~~~,,,~~~~,,~~ttttttt,,,,,,________,,,ttttttt",
+    "ttt,,,@,,,,,tttttt,,,,,,,,,,,,,,~,~~~,,t,,~,~~,,,,,,,,,,,,,,___________,,,,,,ttt",
+    "ttt,,,,=,,,,,tttttttt,,,,,,,,,,,,~~,~~,,,~~,~,,,,,,,,,,,,,_____######____,,ttttt",
+    "tt,,,,,,=,,,,tttttttttttt,,,,,,,,,~,~~,~~~,~,,,,,______________#....#_____,,,,tt",
+    "tt,,,,,,,=,t,tt,ttt,tttt,,,,,,,,,,,,,,,,,,,,,,,,_____________###....###____,,,tt",
+    "tttt,t,,,,=,,,,,,,,,t,,,,,,,,,,,,,,,,,,,,,,,,,,,__#####_#__#_#.#....#.#______,,t",
+    "tttttttt,,,========,,,,t,t,,,,,,,,,,,,,,,,,,t,,,__#...########.#....#.######_,tt",
+    "ttttttttt,,,,,,,,,,===,,tt,,,,,,,,,,,,,,,t,,,,,,__#...#...................##_,,t",
+    "ttttt,,ttttt,tt,tt,,,,=,,tt,,,,,,,,,tt,,,,,,&,&___#.#.#..[.[.[.[...[.[....>#_,tt",
+    "tt,,,,,,,,tttttttttt,,,=,,t,,tttt,,t,,,,,,,=======+...+*****************-..#_,tt",
+    "tttt,,,,,,,,,t,,,tttt,,&=,,,,,,ttt,ttt,,,,=,t,,___#.#.#..[.[.[.[...[.[.....#_,,t",
+    "ttttt,,,,,t,,,,,,,,,,,,,,=&,,,ttttttt,,,,=&,t,,,__#...#...................##_,tt",
+    "ttttt,,,,,,,t,,t,,,,,t,,,,=&,,,,tttttt,&=,,t,t,,__#...########.#....#.######_,tt",
+    "tttttt,,,t,,,,,,,,,,,,t,,,,=,t,ttt,tt,,=,,,tt,,,__#####_#__#_#,#....#.#_____,,,t",
+    "tttttt,,,,,,,,,tttt,,,,,,,,,===========,,,,ttt,,_____________###....###____,,ttt",
+    "tttttt,,,t,,,tttttt,,,,ttt,ttt,,t,t,,ttt,,,,t,,,,______________#....#_____,,,ttt",
+    "ttttttt,,,,,,,ttt,,,,,,,,tttt,,,,tt,t,,,,,,,,,,,,,,,,,,,,______######____,,,tttt",
+    "ttttttt,ttt,tttt,,,,,,,,,,,tttt,,,,tt,,,,tt,,t,,,,,,,,,,,,,,___________,,,t,,,tt",
+    "ttttttttttttttttt,,,t,,,ttttttttt,,,,,,,,,ttttt,,,,ttt,,t,,,,,,,,,,,,,,,tttttttt",
+    "tttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttt"
+};
 
-    TRACE << "Failed to make map template cell from char: " <<  CH << std::endl;
-    ASSERT(false);
-    return Map_templ_cell(0);
-}
+const Map_templ_cell forest_palette[] =
+{
+    {'@', Feature_id::floor},           //Start pos + stone path
+    {'.', Feature_id::floor},           //Stone floor with some grass/shrubs
+    {'#', Feature_id::wall},            //Stone wall with some low/high rubble
+    {',', Feature_id::grass},           //Random grass and bushes
+    {'&', Feature_id::grass},           //Graves, or random grass and bushes
+    {'_', Feature_id::grass},           //Withered grass
+    {'=', Feature_id::floor},           //Stone path
+    {'~', Feature_id::liquid_shallow},  //Shallow water
+    {'t', Feature_id::tree},
+    {'v', Feature_id::brazier},
+    {'[', Feature_id::church_bench},
+    {'-', Feature_id::altar},
+    {'*', Feature_id::carpet},
+    {'>', Feature_id::stairs},
+    {'+', Feature_id::floor}            //Doors
+};
 
-void mk_templ(const std::string& str,
-              const Map_templ_id id,
-              const std::vector<Map_templ_cell>& prototypes)
+//----------------------------------------------------------------- EGYPT
+const char egypt_rows[][MAP_W + 1] =
 {
-    Map_templ& templ = templates_[size_t(id)];
+    "################################################################################",
+    "###...################################........................##################",
+    "###.1.###############################..######################..#################",
+    "###...##############################..#########################.################",
+    "####.##############################..####v....################|....|############",
+    "####.#############################..####..###v..##############......############",
+    "####.##########################.....####..######.v############|....|############",
+    "#####.####.#.#.#.#.###########..######v..#######..###############.##############",
+    "######.##|C........|#########.#######..##########..############..###############",
+    "#######.#...........##.....##.#####...############v.##########..################",
+    "########....M...C....#.#.#.#..####..###...#########..########..#################",
+    "#########..P.....C.#..........####.####.@...........v#######..##################",
+    "########....M...C....#.#.#.#..##|..|###...#################.v###################",
+    "#######.#...........##.....##.##....######################...###################",
+    "######.##|C........|#########.##|..|########......#######.v##.##################",
+    "#####.####.#.#.#.#.##########.####.########..###v..#####..####.#################",
+    "####.########################.####...#####..#####v..###..######.################",
+    "####.########################..#####..###..#######v.....########.###############",
+    "###...########################...####.....#############.#########.###|...|######",
+    "###.2.##########################...##################v..##########........######",
+    "###...############################v....................##############|...|######",
+    "################################################################################"
+};
 
-    std::vector<Map_templ_cell> inner;
+const Map_templ_cell egypt_palette[] =
+{
+    {'@', Feature_id::floor},
+    {'.', Feature_id::floor},
+    {'#', Feature_id::wall},
+    {'v', Feature_id::brazier},
+    {'|', Feature_id::pillar},
+    {'S', Feature_id::statue},
+    {'P', Feature_id::floor, Actor_id::khephren},
+    {'M', Feature_id::floor, Actor_id::mummy},
+    {'C', Feature_id::floor, Actor_id::croc_head_mummy},
+    {'1', Feature_id::floor},   //Stair candidate #1
+    {'2', Feature_id::floor}    //Stair candidate #2
+};
 
-    for (const auto ch : str)
-    {
-        switch (ch)
-        {
-        case ';':
-        {
-            //Delimiting character (";") found, inner vector is pushed to outer
-            templ.add_row(inner);
-            inner.clear();
-        }
-        break;
+//----------------------------------------------------------------- LENG
+const char leng_rows[][MAP_W + 1] =
+{
+    "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%##################################",
+    "%%%%%%%%%%-%%--%--%%--%%%--%%--%%-%-%%%--%-%%-#.....#.....#.....#..............#",
+    "%@----%--------%---%---%--------%----%-----%--#.....#.....#.....#..............#",
+    "%%--------------------------------------------###.#####.#####.###..............#",
+    "%-------------%--------------------------%----#.................#..............#",
+    "%%------------%-------------------------------#...###.#####.###................#",
+    "%%---------------------%%%--------------%-----#...#.....#.....##################",
+    "%%%----%%---------------S%--------------------#...#.....#.....##################",
+    "%%%------------------%%-S%S------%------------#...################............##",
+    "%%%%-----------------%--%%-%----%%------------#......#...#......##.....$......##",
+    "%%%--------------------%%S--------------------##.###.#...#......###.$.....$...##",
+    "%%------------------%-%%S---------------------+......#...######...1.........E.##",
+    "%%%-------------------S%%S-%------------------##.###.#...#......###.$.....$...##",
+    "%%-------------------%-S%%-%----%-------------#...#..###.#.#######.....$......##",
+    "%%---------------------S%%S-------------------#...#......#......##............##",
+    "%%%------------------%-%%---------------%-----#.###############.#############2##",
+    "%%-----%---------------------------%----------#.#...............#############.##",
+    "%%%---------%---------------------------------#.#.###.###.###.#.####....#####..#",
+    "%%--%-----------------------------------------#.#.###.###.###.#.##...##...####.#",
+    "%%%--------------%----------------%---%-----%-#.#.###.###.###.#.#..######....#.#",
+    "%%%%%%--%---%--%%%-%--%%%%%%%-%-%%%--%%--%-%%%#...............#...##########...#",
+    "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%##################################"
+};
 
-        case ' ':
-        {
-            inner.push_back(Map_templ_cell(0));
-        }
-        break;
+const Map_templ_cell leng_palette[] =
+{
+    {'@', Feature_id::floor},
+    {'%', Feature_id::wall},
+    {'.', Feature_id::floor},
+    {'#', Feature_id::wall},
+    {'E', Feature_id::floor, Actor_id::leng_elder},
+    {'1', Feature_id::floor},
+    {'2', Feature_id::wall},
+    {'$', Feature_id::altar},
+    {'-', Feature_id::grass},
+    {'+', Feature_id::floor}, //Door
+    {'S', Feature_id::grass, Actor_id::leng_spider}
+};
 
-        default:
-        {
-            Map_templ_cell templ_cell = ch_to_cell(ch, prototypes);
+//----------------------------------------------------------------- RATS IN THE WALLS
+const char rats_in_the_walls_rows[][MAP_W + 1] =
+{
+    "################################################################################",
+    "##@#################,##,##xxxxxxxxx###xxxxxxxxxxx######rr#,##########,#,########",
+    "##.##############,,,,,,,,,x,,,,,,,xrrrxrr,rrr,rrxr,rrrr,,,,,,##,,#,,,,,,,#######",
+    "##...&##########,,,,xxxxxxx,,,,,,,xr,rxr,,,,,,,rxrrr,,,,,:,,,,,,,,,,,:,,,,######",
+    "###..:#########,,:,,x,,,,,,,,,,,,,,,,rrrrxx,xxrrxr,r,,,,,,,,,,,,,,,,,,,,,,,,,###",
+    "###:...#######,,,,,,xx,xxxx,,,,,,,xrrrxrrx,,,xrrxrrr,,,,,,,,:,,,,,,:,,,,,,######",
+    "##&..:..#####,,,,,,,,,,,,,xxxx,xxxx,r,xxxx,,,x,xx,,,,,,,,,,,,,,,,,,,,,,,,,######",
+    "####.&.:####,,,,,,,,,,,,,,,:,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,:,,,,,####",
+    "####..##&:1.,,,,,,,,,:,,,,,,,,,,:,,,,,,,,,,,|,,,:,,,xxx,xx,xxx,,,,,,,,,,,,,#####",
+    "#####..&:.#,,,,,,,,,,,,,,,x,x,x,x,x,x,,,,|,,,,,|,,,rx,,,,,,,,x,,,,:,,,,,,,######",
+    "###########,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,x,rrrrr,,x,,,,,,,,,,,#######",
+    "###########,,,,,,,,|,,,,,,,,,,,,,,,,:,,,|,,,,,,,|,,rr,,,,,r,,,,,,,#,,,,,########",
+    "###########,,,,,|,,,,,|,,,,,,,,,,,,,,,,,,,,,,,,,,,,,x,r,rr,,,x,,####,,,,,#######",
+    "###########,,,,,,,,,,,,,,,x,x,x,x,x,x,,,,|,,,,,|,,,rx,,rrr,,,x,,,,##############",
+    "############,,,|,,,,,,,|,,,,,,,,,,,,,,,,,,,,|,,,,,x,x,r,,r,,,x,,,###############",
+    "############,,,,,,,,,,,,,,,,,,,,:,,,,,,,,,,,,,,,,,rr,,,rr,,,,x,:##xxxxxx########",
+    "#############,,,|,,,,,|,,,xxx,xxxxx,xxx,,,:,,,,r,,,rx,rr,,,,,x,,,,x....x########",
+    "##############,,,,,|,,,,,,x,,,,,xrrrrrx,,,,,,,,,,,r,x,r,,,,,rx,,,,...>.x########",
+    "#################,,,,,,:,,x,,,,,xrr,,rxrr,rr,rr,r,,,xxxxxxxxxx,:,,x....x########",
+    "################:,,,,,,,,,x,,,,,xrrrrrxrrrr##rrr,r,,rr,rr,rr,r,##:xxxxxx########",
+    "###################:,,####xxxxxxxxxxxxx##r#####rr###r###r#rrr###################",
+    "################################################################################"
+};
 
-            inner.push_back(templ_cell);
-        }
-        break;
-        }
-    }
-}
+const Map_templ_cell rats_in_the_walls_palette[] =
+{
+    {'@', Feature_id::floor},
+    {'.', Feature_id::floor},
+    {'#', Feature_id::wall},
+    {'x', Feature_id::wall},                    //Constructed walls
+    {'&', Feature_id::bones},
+    {'1', Feature_id::floor},                   //Discovery event
+    {',', Feature_id::floor},                   //Random bones
+    {'r', Feature_id::floor, Actor_id::rat},    //Random bones + rat
+    {'>', Feature_id::stairs},
+    {'|', Feature_id::monolith},
+    {':', Feature_id::stalagmite}
+};
 
-void init_templs()
+//----------------------------------------------------------------- BOSS LEVEL
+const char boss_level_rows[][MAP_W + 1] =
 {
-    //Blank level with correct dimensions to copy/paste when making new templates
-//  "################################################################################;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "#..............................................................................#;"
-//  "################################################################################;";
-
-    //Filled version
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;"
-//  "################################################################################;";
-
-    //----------------------------------------------------------------- FOREST
-    std::string str =
-        "tttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttt;"
-        "tttttttttttttttttt,,,,,,,,,,tttttttt~~~~~~~~tttttttttt,,,tt,t,,t,,ttt,,ttttttttt;"
-        "tttt,=,,,,ttttttt,,,,,t,,,,tttt~,~,~~~,,,~~~~,,~~ttttttt,,,,,,________,,,ttttttt;"
-        "ttt,,,@,,,,,tttttt,,,,,,,,,,,,,,~,~~~,,t,,~,~~,,,,,,,,,,,,,,___________,,,,,,ttt;"
-        "ttt,,,,=,,,,,tttttttt,,,,,,,,,,,,~~,~~,,,~~,~,,,,,,,,,,,,,_____######____,,ttttt;"
-        "tt,,,,,,=,,,,tttttttttttt,,,,,,,,,~,~~,~~~,~,,,,,______________#....#_____,,,,tt;"
-        "tt,,,,,,,=,t,tt,ttt,tttt,,,,,,,,,,,,,,,,,,,,,,,,_____________###....###____,,,tt;"
-        "tttt,t,,,,=,,,,,,,,,t,,,,,,,,,,,,,,,,,,,,,,,,,,,__#####_#__#_#.#....#.#______,,t;"
-        "tttttttt,,,========,,,,t,t,,,,,,,,,,,,,,,,,,t,,,__#...########.#....#.######_,tt;"
-        "ttttttttt,,,,,,,,,,===,,tt,,,,,,,,,,,,,,,t,,,,,,__#...#...................##_,,t;"
-        "ttttt,,ttttt,tt,tt,,,,=,,tt,,,,,,,,,tt,,,,,,&,&___#.#.#..[.[.[.[...[.[....>#_,tt;"
-        "tt,,,,,,,,tttttttttt,,,=,,t,,tttt,,t,,,,,,,=======+...+*****************-..#_,tt;"
-        "tttt,,,,,,,,,t,,,tttt,,&=,,,,,,ttt,ttt,,,,=,t,,___#.#.#..[.[.[.[...[.[.....#_,,t;"
-        "ttttt,,,,,t,,,,,,,,,,,,,,=&,,,ttttttt,,,,=&,t,,,__#...#...................##_,tt;"
-        "ttttt,,,,,,,t,,t,,,,,t,,,,=&,,,,tttttt,&=,,t,t,,__#...########.#....#.######_,tt;"
-        "tttttt,,,t,,,,,,,,,,,,t,,,,=,t,ttt,tt,,=,,,tt,,,__#####_#__#_#,#....#.#_____,,,t;"
-        "tttttt,,,,,,,,,tttt,,,,,,,,,===========,,,,ttt,,_____________###....###____,,ttt;"
-        "tttttt,,,t,,,tttttt,,,,ttt,ttt,,t,t,,ttt,,,,t,,,,______________#....#_____,,,ttt;"
-        "ttttttt,,,,,,,ttt,,,,,,,,tttt,,,,tt,t,,,,,,,,,,,,,,,,,,,,______######____,,,tttt;"
-        "ttttttt,ttt,tttt,,,,,,,,,,,tttt,,,,tt,,,,tt,,t,,,,,,,,,,,,,,___________,,,t,,,tt;"
-        "ttttttttttttttttt,,,t,,,ttttttttt,,,,,,,,,ttttt,,,,ttt,,t,,,,,,,,,,,,,,,tttttttt;"
-        "tttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttttt;";
-
-    mk_templ(str, Map_templ_id::intro_forest, std::vector<Map_templ_cell>
-    {
-        {'@', Feature_id::floor},           //Start pos + stone path
-        {'.', Feature_id::floor},           //Stone floor with some grass/shrubs
-        {'#', Feature_id::wall},            //Stone wall with some low/high rubble
-        {',', Feature_id::grass},           //Random grass and bushes
-        {'&', Feature_id::grass},           //Graves, or random grass and bushes
-        {'_', Feature_id::grass},           //Withered grass
-        {'=', Feature_id::floor},           //Stone path
-        {'~', Feature_id::liquid_shallow},  //Shallow water
-        {'t', Feature_id::tree},
-        {'v', Feature_id::brazier},
-        {'[', Feature_id::church_bench},
-        {'-', Feature_id::altar},
-        {'*', Feature_id::carpet},
-        {'>', Feature_id::stairs},
-        {'+', Feature_id::floor}            //Doors
-    });
-
-    //----------------------------------------------------------------- EGYPT
-    str =
-        "################################################################################;"
-        "###...################################........................##################;"
-        "###.1.###############################..######################..#################;"
-        "###...##############################..#########################.################;"
-        "####.##############################..####v....################|....|############;"
-        "####.#############################..####..###v..##############......############;"
-        "####.##########################.....####..######.v############|....|############;"
-        "#####.####.#.#.#.#.###########..######v..#######..###############.##############;"
-        "######.##|C........|#########.#######..##########..############..###############;"
-        "#######.#...........##.....##.#####...############v.##########..################;"
-        "########....M...C....#.#.#.#..####..###...#########..########..#################;"
-        "#########..P.....C.#..........####.####.@...........v#######..##################;"
-        "########....M...C....#.#.#.#..##|..|###...#################.v###################;"
-        "#######.#...........##.....##.##....######################...###################;"
-        "######.##|C........|#########.##|..|########......#######.v##.##################;"
-        "#####.####.#.#.#.#.##########.####.########..###v..#####..####.#################;"
-        "####.########################.####...#####..#####v..###..######.################;"
-        "####.########################..#####..###..#######v.....########.###############;"
-        "###...########################...####.....#############.#########.###|...|######;"
-        "###.2.##########################...##################v..##########........######;"
-        "###...############################v....................##############|...|######;"
-        "################################################################################;";
-
-    mk_templ(str, Map_templ_id::egypt, std::vector<Map_templ_cell>
-    {
-        {'@', Feature_id::floor},
-        {'.', Feature_id::floor},
-        {'#', Feature_id::wall},
-        {'v', Feature_id::brazier},
-        {'|', Feature_id::pillar},
-        {'S', Feature_id::statue},
-        {'P', Feature_id::floor, Actor_id::khephren},
-        {'M', Feature_id::floor, Actor_id::mummy},
-        {'C', Feature_id::floor, Actor_id::croc_head_mummy},
-        {'1', Feature_id::floor},   //Stair candidate #1
-        {'2', Feature_id::floor}    //Stair candidate #2
-    });
-
-    //----------------------------------------------------------------- LENG
-    str =
-        "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%##################################;"
-        "%%%%%%%%%%-%%--%--%%--%%%--%%--%%-%-%%%--%-%%-#.....#.....#.....#..............#;"
-        "%@----%--------%---%---%--------%----%-----%--#.....#.....#.....#..............#;"
-        "%%--------------------------------------------###.#####.#####.###..............#;"
-        "%-------------%--------------------------%----#.................#..............#;"
-        "%%------------%-------------------------------#...###.#####.###................#;"
-        "%%---------------------%%%--------------%-----#...#.....#.....##################;"
-        "%%%----%%---------------S%--------------------#...#.....#.....##################;"
-        "%%%------------------%%-S%S------%------------#...################............##;"
-        "%%%%-----------------%--%%-%----%%------------#......#...#......##.....$......##;"
-        "%%%--------------------%%S--------------------##.###.#...#......###.$.....$...##;"
-        "%%------------------%-%%S---------------------+......#...######...1.........E.##;"
-        "%%%-------------------S%%S-%------------------##.###.#...#......###.$.....$...##;"
-        "%%-------------------%-S%%-%----%-------------#...#..###.#.#######.....$......##;"
-        "%%---------------------S%%S-------------------#...#......#......##............##;"
-        "%%%------------------%-%%---------------%-----#.###############.#############2##;"
-        "%%-----%---------------------------%----------#.#...............#############.##;"
-        "%%%---------%---------------------------------#.#.###.###.###.#.####....#####..#;"
-        "%%--%-----------------------------------------#.#.###.###.###.#.##...##...####.#;"
-        "%%%--------------%----------------%---%-----%-#.#.###.###.###.#.#..######....#.#;"
-        "%%%%%%--%---%--%%%-%--%%%%%%%-%-%%%--%%--%-%%%#...............#...##########...#;"
-        "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%##################################;";
-
-    mk_templ(str, Map_templ_id::leng, std::vector<Map_templ_cell>
-    {
-        {'@', Feature_id::floor},
-        {'%', Feature_id::wall},
-        {'.', Feature_id::floor},
-        {'#', Feature_id::wall},
-        {'E', Feature_id::floor, Actor_id::leng_elder},
-        {'1', Feature_id::floor},
-        {'2', Feature_id::wall},
-        {'$', Feature_id::altar},
-        {'-', Feature_id::grass},
-        {'+', Feature_id::floor}, //Door
-        {'S', Feature_id::grass, Actor_id::leng_spider}
-    });
-
-    //----------------------------------------------------------------- RATS IN THE WALLS
-    str =
-        "################################################################################;"
-        "##@#################,##,##xxxxxxxxx###xxxxxxxxxxx######rr#,##########,#,########;"
-        "##.##############,,,,,,,,,x,,,,,,,xrrrxrr,rrr,rrxr,rrrr,,,,,,##,,#,,,,,,,#######;"
-        "##...&##########,,,,xxxxxxx,,,,,,,xr,rxr,,,,,,,rxrrr,,,,,:,,,,,,,,,,,:,,,,######;"
-        "###..:#########,,:,,x,,,,,,,,,,,,,,,,rrrrxx,xxrrxr,r,,,,,,,,,,,,,,,,,,,,,,,,,###;"
-        "###:...#######,,,,,,xx,xxxx,,,,,,,xrrrxrrx,,,xrrxrrr,,,,,,,,:,,,,,,:,,,,,,######;"
-        "##&..:..#####,,,,,,,,,,,,,xxxx,xxxx,r,xxxx,,,x,xx,,,,,,,,,,,,,,,,,,,,,,,,,######;"
-        "####.&.:####,,,,,,,,,,,,,,,:,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,:,,,,,####;"
-        "####..##&:1.,,,,,,,,,:,,,,,,,,,,:,,,,,,,,,,,|,,,:,,,xxx,xx,xxx,,,,,,,,,,,,,#####;"
-        "#####..&:.#,,,,,,,,,,,,,,,x,x,x,x,x,x,,,,|,,,,,|,,,rx,,,,,,,,x,,,,:,,,,,,,######;"
-        "###########,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,x,rrrrr,,x,,,,,,,,,,,#######;"
-        "###########,,,,,,,,|,,,,,,,,,,,,,,,,:,,,|,,,,,,,|,,rr,,,,,r,,,,,,,#,,,,,########;"
-        "###########,,,,,|,,,,,|,,,,,,,,,,,,,,,,,,,,,,,,,,,,,x,r,rr,,,x,,####,,,,,#######;"
-        "###########,,,,,,,,,,,,,,,x,x,x,x,x,x,,,,|,,,,,|,,,rx,,rrr,,,x,,,,##############;"
-        "############,,,|,,,,,,,|,,,,,,,,,,,,,,,,,,,,|,,,,,x,x,r,,r,,,x,,,###############;"
-        "############,,,,,,,,,,,,,,,,,,,,:,,,,,,,,,,,,,,,,,rr,,,rr,,,,x,:##xxxxxx########;"
-        "#############,,,|,,,,,|,,,xxx,xxxxx,xxx,,,:,,,,r,,,rx,rr,,,,,x,,,,x....x########;"
-        "##############,,,,,|,,,,,,x,,,,,xrrrrrx,,,,,,,,,,,r,x,r,,,,,rx,,,,...>.x########;"
-        "#################,,,,,,:,,x,,,,,xrr,,rxrr,rr,rr,r,,,xxxxxxxxxx,:,,x....x########;"
-        "################:,,,,,,,,,x,,,,,xrrrrrxrrrr##rrr,r,,rr,rr,rr,r,##:xxxxxx########;"
-        "###################:,,####xxxxxxxxxxxxx##r#####rr###r###r#rrr###################;"
-        "################################################################################;";
-
-    mk_templ(str, Map_templ_id::rats_in_the_walls, std::vector<Map_templ_cell>
-    {
-        {'@', Feature_id::floor},
-        {'.', Feature_id::floor},
-        {'#', Feature_id::wall},
-        {'x', Feature_id::wall},                    //Constructed walls
-        {'&', Feature_id::bones},
-        {'1', Feature_id::floor},                   //Discovery event
-        {',', Feature_id::floor},                   //Random bones
-        {'r', Feature_id::floor, Actor_id::rat},    //Random bones + rat
-        {'>', Feature_id::stairs},
-        {'|', Feature_id::monolith},
-        {':', Feature_id::stalagmite}
-    });
-
-    //----------------------------------------------------------------- BOSS LEVEL
-    str =
-        "################################################################################;"
-        "############################...................................................#;"
-        "############################...................................................#;"
-        "############################...#.....#...#.....#...#.....#...#.....#...........#;"
-        "############################...###.###...###.###...###.###...###.###...........#;"
-        "##############....#########......###.......###.......###.......###.............#;"
-        "##############....#########....###.###...###.###...###.###...###.###...........#;"
-        "############.#....#.#######....#.....#...#.....#...#.....#...#.....#...........#;"
-        "#...########.#....#.#######.................................................####;"
-        "#...#...................#.#.......|....|....|....|....|....|....#...#...#...####;"
-        "#.#.#.............................................................v...v...v..###;"
-        "#@..............................................................#.....M......###;"
-        "#.#.#.............................................................v...v...v..###;"
-        "#...#...................#.#.......|....|....|....|....|....|....#...#...#...####;"
-        "#...########.#....#.#######.................................................####;"
-        "############.#....#.#######....#.....#...#.....#...#.....#...#.....#...........#;"
-        "##############....#########....###.###...###.###...###.###...###.###...........#;"
-        "##############....#########......###.......###.......###.......###.............#;"
-        "############################...###.###...###.###...###.###...###.###...........#;"
-        "############################...#.....#...#.....#...##...##...#.....#...........#;"
-        "############################...................................................#;"
-        "################################################################################;";
-
-    mk_templ(str, Map_templ_id::boss_level, std::vector<Map_templ_cell>
-    {
-        {'@', Feature_id::floor},
-        {'.', Feature_id::floor},
-        {'#', Feature_id::wall},
-        {'M', Feature_id::floor, Actor_id::the_high_priest},
-        {'|', Feature_id::pillar},
-        {'v', Feature_id::brazier},
-        {'>', Feature_id::stairs}
-    });
-
-    //----------------------------------------------------------------- BOSS LEVEL
-    str =
-        "################################################################################;"
-        "#####################################...|...####################################;"
-        "#####################################.|...|.####################################;"
-        "#####################################...|...####################################;"
-        "####################################..|...|..###################################;"
-        "###################################.....|.....##################################;"
-        "##################################....|...|....#################################;"
-        "#################################...#.......#...################################;"
-        "#######.......................##..#.#.##.##.#.#..##.......######################;"
-        "#######.|.|.|.|.|.|.|.|.|.|.|.#v..|.v.|...|.v.|..v#.|.|.|.######################;"
-        "#######..@..............................o.................######################;"
-        "#######.|.|.|.|.|.|.|.|.|.|.|.#v..|.v.|...|.v.|..v#.|.|.|.######################;"
-        "#######.......................##..#.#.##.##.#.#..##.......######################;"
-        "#################################...#.......#...################################;"
-        "##################################....|...|....#################################;"
-        "###################################.....|.....##################################;"
-        "####################################..|...|..###################################;"
-        "#####################################...|...####################################;"
-        "#####################################.|...|.####################################;"
-        "#####################################...|...####################################;"
-        "################################################################################;"
-        "################################################################################;";
-
-    mk_templ(str, Map_templ_id::trapez_level, std::vector<Map_templ_cell>
-    {
-        {'@', Feature_id::floor},
-        {'.', Feature_id::floor},
-        {'#', Feature_id::wall},
-        {'|', Feature_id::pillar},
-        {'v', Feature_id::brazier},
-        {'o', Feature_id::floor, Actor_id::END, Item_id::trapez}
-    });
+    "################################################################################",
+    "############################...................................................#",
+    "############################...................................................#",
+    "############################...#.....#...#.....#...#.....#...#.....#...........#",
+    "############################...###.###...###.###...###.###...###.###...........#",
+    "##############....#########......###.......###.......###.......###.............#",
+    "##############....#########....###.###...###.###...###.###...###.###...........#",
+    "############.#....#.#######....#.....#...#.....#...#.....#...#.....#...........#",
+    "#...########.#....#.#######.................................................####",
+    "#...#...................#.#.......|....|....|....|....|....|....#...#...#...####",
+    "#.#.#.............................................................v...v...v..###",
+    "#@..............................................................#.....M......###",
+    "#.#.#.............................................................v...v...v..###",
+    "#...#...................#.#.......|....|....|....|....|....|....#...#...#...####",
+    "#...########.#....#.#######.................................................####",
+    "############.#....#.#######....#.....#...#.....#...#.....#...#.....#...........#",
+    "##############....#########....###.###...###.###...###.###...###.###...........#",
+    "##############....#########......###.......###.......###.......###.............#",
+    "############################...###.###...###.###...###.###...###.###...........#",
+    "############################...#.....#...#.....#...##...##...#.....#...........#",
+    "############################...................................................#",
+    "################################################################################"
+};
+
+const Map_templ_cell boss_level_palette[] =
+{
+    {'@', Feature_id::floor},
+    {'.', Feature_id::floor},
+    {'#', Feature_id::wall},
+    {'M', Feature_id::floor, Actor_id::the_high_priest},
+    {'|', Feature_id::pillar},
+    {'v', Feature_id::brazier},
+    {'>', Feature_id::stairs}
+};
+
+//----------------------------------------------------------------- TRAPEZOHEDRON LEVEL
+const char trapez_level_rows[][MAP_W + 1] =
+{
+    "################################################################################",
+    "#####################################...|...####################################",
+    "#####################################.|...|.####################################",
+    "#####################################...|...####################################",
+    "####################################..|...|..###################################",
+    "###################################.....|.....##################################",
+    "##################################....|...|....#################################",
+    "#################################...#.......#...################################",
+    "#######.......................##..#.#.##.##.#.#..##.......######################",
+    "#######.|.|.|.|.|.|.|.|.|.|.|.#v..|.v.|...|.v.|..v#.|.|.|.######################",
+    "#######..@..............................o.................######################",
+    "#######.|.|.|.|.|.|.|.|.|.|.|.#v..|.v.|...|.v.|..v#.|.|.|.######################",
+    "#######.......................##..#.#.##.##.#.#..##.......######################",
+    "#################################...#.......#...################################",
+    "##################################....|...|....#################################",
+    "###################################.....|.....##################################",
+    "####################################..|...|..###################################",
+    "#####################################...|...####################################",
+    "#####################################.|...|.####################################",
+    "#####################################...|...####################################",
+    "################################################################################",
+    "################################################################################"
+};
+
+const Map_templ_cell trapez_level_palette[] =
+{
+    {'@', Feature_id::floor},
+    {'.', Feature_id::floor},
+    {'#', Feature_id::wall},
+    {'|', Feature_id::pillar},
+    {'v', Feature_id::brazier},
+    {'o', Feature_id::floor, Actor_id::END, Item_id::trapez}
+};
+
+template<size_t W, size_t H, size_t NR_PALETTE_CELLS>
+void add_templ(const Map_templ_id id,
+               const char (&rows)[H][W],
+               const Map_templ_cell (&palette)[NR_PALETTE_CELLS])
+{
+    //NOTE: The row width includes the null terminator
+    templates_[size_t(id)] = Map_templ(&rows[0][0],
+                                       P(W - 1, H),
+                                       palette,
+                                       NR_PALETTE_CELLS);
 }
 
 } //namespace
 
 void init()
 {
-    init_templs();
+    TRACE_FUNC_BEGIN;
+
+    add_templ(Map_templ_id::intro_forest,       forest_rows,            forest_palette);
+    add_templ(Map_templ_id::egypt,              egypt_rows,             egypt_palette);
+    add_templ(Map_templ_id::leng,               leng_rows,              leng_palette);
+    add_templ(Map_templ_id::rats_in_the_walls,  rats_in_the_walls_rows, rats_in_the_walls_palette);
+    add_templ(Map_templ_id::boss_level,         boss_level_rows,        boss_level_palette);
+    add_templ(Map_templ_id::trapez_level,       trapez_level_rows,      trapez_level_palette);
+
+    TRACE_FUNC_END;
 }
 
 const Map_templ& templ(const Map_templ_id id)
@@ -15,6 +15,9 @@
 #include "msg_log.hpp"
 #include "feature_rigid.hpp"
 #include "save_handling.hpp"
+#include "profiler.hpp"
+#include "config.hpp"
+#include "fov.hpp"
 
 #include "sdl_wrapper.hpp" // *** Temporary ***
 
@@ -28,6 +31,8 @@ namespace
 
 void mk_lvl(const Map_type& map_type)
 {
+    PROFILE_ZONE("map_travel::mk_lvl");
+
     TRACE_FUNC_BEGIN;
 
     bool map_ok = false;
@@ -35,6 +40,8 @@ void mk_lvl(const Map_type& map_type)
 #ifndef NDEBUG
     int   nr_attempts  = 0;
     auto  start_time   = std::chrono::steady_clock::now();
+
+    mapgen::reset_phase_stats();
 #endif
 
     //TODO: When the map is invalid, any unique items spawned are lost forever.
@@ -80,12 +87,35 @@ void mk_lvl(const Map_type& map_type)
         }
     }
 
+    //Map generation sets darkness directly on the cells, and places the player
+    //directly - discard any line of sight results and actor positions stored
+    //while building the map
+    fov::on_los_changed();
+
+    map::invalidate_actor_index();
+
 #ifndef NDEBUG
     auto diff_time = std::chrono::steady_clock::now() - start_time;
 
     TRACE << "map built after   " << nr_attempts << " attempt(s). " << std::endl
           << "Total time taken: "
           << std::chrono::duration<double, std::milli>(diff_time).count() << " ms" << std::endl;
+
+    //Log the time and rejections of each map generation phase (when the bot is
+    //playing, many levels are built, so this gives useful statistics)
+    if (config::is_bot_playing() && map_type == Map_type::std)
+    {
+        for (size_t i = 0; i < size_t(Mapgen_phase::END); ++i)
+        {
+            const Mapgen_phase          phase = Mapgen_phase(i);
+            const Mapgen_phase_stats&   stats = mapgen::phase_stats(phase);
+
+            TRACE << "Mapgen phase " << mapgen::phase_name(phase)
+                  << ": runs: "         << stats.nr_runs
+                  << ", rejections: "   << stats.nr_rejections
+                  << ", time: "         << stats.ms_tot << " ms" << std::endl;
+        }
+    }
 #endif
 
     TRACE_FUNC_END;
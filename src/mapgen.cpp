@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <chrono>
 
 #include "room.hpp"
 #include "mapgen.hpp"
@@ -21,6 +22,7 @@
 #include "populate_traps.hpp"
 #include "populate_items.hpp"
 #include "gods.hpp"
+#include "profiler.hpp"
 #include "rl_utils.hpp"
 
 #ifdef DEMO_MODE
@@ -52,6 +54,74 @@ namespace
 //All cells marked as true in this array will be considered for door placement
 bool door_proposals[MAP_W][MAP_H];
 
+Mapgen_phase_stats phase_stats_[size_t(Mapgen_phase::END)];
+
+#ifdef PROFILING
+//Profiler zone names (the profiler stores the name pointer, so these must be
+//string literals)
+const char* const phase_zone_names[size_t(Mapgen_phase::END)] =
+{
+    "mapgen::init",
+    "mapgen::regions",
+    "mapgen::main_rooms",
+    "mapgen::aux_rooms",
+    "mapgen::sub_rooms",
+    "mapgen::pre_connect",
+    "mapgen::connect_rooms",
+    "mapgen::post_connect",
+    "mapgen::fill_dead_ends",
+    "mapgen::doors",
+    "mapgen::player_pos",
+    "mapgen::decorate",
+    "mapgen::populate",
+    "mapgen::place_stairs",
+    "mapgen::finalize"
+};
+#endif //PROFILING
+
+//Adds the time spent in a phase to the phase statistics, and counts the phase as
+//rejecting the map if the map became invalid during the phase. When profiling,
+//each phase is also a profiler zone.
+class Phase_scope
+{
+public:
+    Phase_scope(const Mapgen_phase phase) :
+#ifdef PROFILING
+        zone_           (phase_zone_names[size_t(phase)]),
+#endif //PROFILING
+        phase_          (phase),
+        was_map_valid_  (is_map_valid),
+        start_          (std::chrono::steady_clock::now()) {}
+
+    ~Phase_scope()
+    {
+        const auto diff_time = std::chrono::steady_clock::now() - start_;
+
+        Mapgen_phase_stats& stats = phase_stats_[size_t(phase_)];
+
+        ++stats.nr_runs;
+
+        stats.ms_tot += std::chrono::duration<double, std::milli>(diff_time).count();
+
+        if (was_map_valid_ && !is_map_valid)
+        {
+            ++stats.nr_rejections;
+        }
+    }
+
+private:
+    Phase_scope(const Phase_scope&) = delete;
+    Phase_scope& operator=(const Phase_scope&) = delete;
+
+#ifdef PROFILING
+    profiler::Zone                                  zone_;
+#endif //PROFILING
+
+    const Mapgen_phase                              phase_;
+    const bool                                      was_map_valid_;
+    const std::chrono::steady_clock::time_point     start_;
+};
+
 bool is_all_rooms_connected()
 {
     bool blocked[MAP_W][MAP_H];
@@ -92,10 +162,99 @@ void mk_floor_in_room(const Room& room)
     }
 }
 
+bool is_std_room(const Room& r)
+{
+    return (int)r.type_ < (int)Room_type::END_OF_STD_ROOMS;
+}
+
+//Checks if another room (except for sub rooms) lies anywhere in a rectangle
+//defined by the two center points of the rooms
+bool is_other_room_in_way(const Room& room0, const Room& room1)
+{
+    const P c0(room0.r_.center());
+    const P c1(room1.r_.center());
+
+    const int X0 = std::min(c0.x, c1.x);
+    const int Y0 = std::min(c0.y, c1.y);
+    const int X1 = std::max(c0.x, c1.x);
+    const int Y1 = std::max(c0.y, c1.y);
+
+    for (int x = X0; x <= X1; ++x)
+    {
+        for (int y = Y0; y <= Y1; ++y)
+        {
+            const Room* const room_here = map::room_map[x][y];
+
+            if (
+                room_here               &&
+                room_here != &room0     &&
+                room_here != &room1     &&
+                !room_here->is_sub_room_)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool is_already_connected(const Room& room0, const Room& room1)
+{
+    const auto& room0_connections = room0.rooms_con_to_;
+
+    return find(room0_connections.begin(),
+                room0_connections.end(),
+                &room1) != room0_connections.end();
+}
+
+//Checks if there is any pair of rooms which connect_rooms() is allowed to
+//connect - if not, it can never succeed (it would try until it gives up)
+bool has_connectable_rooms()
+{
+    for (const Room* const room0 : map::room_list)
+    {
+        if (!is_std_room(*room0) && room0->type_ != Room_type::corr_link)
+        {
+            continue;
+        }
+
+        for (const Room* const room1 : map::room_list)
+        {
+            if (
+                room1 != room0                          &&
+                is_std_room(*room1)                     &&
+                !is_already_connected(*room0, *room1)   &&
+                !is_other_room_in_way(*room0, *room1))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 void connect_rooms()
 {
     TRACE_FUNC_BEGIN;
 
+    if (!has_connectable_rooms())
+    {
+        TRACE << "No rooms can be connected, discarding map" << std::endl;
+        mapgen::mk_map_invalid(Map_invalid_reason::no_connectable_rooms);
+        TRACE_FUNC_END;
+        return;
+    }
+
+    //NOTE: Connecting rooms only adds corridor links, so this does not change
+    const auto NR_STD_ROOMS = std::count_if(begin(map::room_list),
+                                            end(map::room_list),
+                                            [](const Room* const room)
+    {
+        return is_std_room(*room);
+    });
+
     int nr_tries_left = 5000;
 
     while (true)
@@ -106,7 +265,7 @@ void connect_rooms()
 
         if (nr_tries_left == 0)
         {
-            mapgen::is_map_valid = false;
+            mapgen::mk_map_invalid(Map_invalid_reason::connect_rooms);
 #ifdef DEMO_MODE
             render::cover_panel(Panel::log);
             render::draw_text("Failed to connect map",
@@ -124,11 +283,6 @@ void connect_rooms()
             return map::room_list[rnd::range(0, map::room_list.size() - 1)];
         };
 
-        auto is_std_room = [](const Room & r)
-        {
-            return (int)r.type_ < (int)Room_type::END_OF_STD_ROOMS;
-        };
-
         Room* room0 = rnd_room();
 
         //Room 0 must be a standard room or corridor link
@@ -139,6 +293,13 @@ void connect_rooms()
             continue;
         }
 
+        //If room 0 is the only standard room, there is no other room which it
+        //can be connected to (it can only be connected from corridor links)
+        if (is_std_room(*room0) && NR_STD_ROOMS < 2)
+        {
+            continue;
+        }
+
         //Finding second room to connect to
         Room* room1 = rnd_room();
 
@@ -153,12 +314,7 @@ void connect_rooms()
         }
 
         //Do not allow two rooms to be connected twice
-        const auto& room0_connections = room0->rooms_con_to_;
-
-        if (
-            find(room0_connections.begin(),
-                 room0_connections.end(),
-                 room1) != room0_connections.end())
+        if (is_already_connected(*room0, *room1))
         {
             //Rooms are already connected, trying other combination
             continue;
@@ -167,40 +323,7 @@ void connect_rooms()
         //Do not connect room 0 and 1 if another room (except for sub rooms)
         //lies anywhere in a rectangle defined by the two center points of
         //those rooms.
-        bool is_other_room_in_way = false;
-
-        const P c0(room0->r_.center());
-        const P c1(room1->r_.center());
-
-        const int X0 = std::min(c0.x, c1.x);
-        const int Y0 = std::min(c0.y, c1.y);
-        const int X1 = std::max(c0.x, c1.x);
-        const int Y1 = std::max(c0.y, c1.y);
-
-        for (int x = X0; x <= X1; ++x)
-        {
-            for (int y = Y0; y <= Y1; ++y)
-            {
-                const Room* const room_here = map::room_map[x][y];
-
-                if (
-                    room_here           &&
-                    room_here != room0  &&
-                    room_here != room1  &&
-                    !room_here->is_sub_room_)
-                {
-                    is_other_room_in_way = true;
-                    break;
-                }
-            }
-
-            if (is_other_room_in_way)
-            {
-                break;
-            }
-        }
-
-        if (is_other_room_in_way)
+        if (is_other_room_in_way(*room0, *room1))
         {
             //Blocked by room between, trying other combination
             continue;
@@ -934,7 +1057,7 @@ void mk_sub_rooms()
                 {
                     //Not possible to place an entrance to the inner room,
                     //Discard this map!
-                    is_map_valid = false;
+                    mk_map_invalid(Map_invalid_reason::inner_room_entrance);
                     return;
                 }
 
@@ -1076,7 +1199,7 @@ void decorate()
     {
         for (int y = 0; y < MAP_H; ++y)
         {
-            Cell& cell = map::cells[x][y];
+            Cell cell = map::cells[x][y];
 
             if (cell.rigid->id() == Feature_id::wall)
             {
@@ -1111,7 +1234,7 @@ void decorate()
 
                         if (map::is_pos_inside_map(p_adj))
                         {
-                            auto& adj_cell = map::cells[p_adj.x][p_adj.y];
+                            Cell adj_cell = map::cells[p_adj.x][p_adj.y];
 
                             const auto adj_id = adj_cell.rigid->id();
 
@@ -1215,8 +1338,11 @@ P place_stairs()
     bool allowed_cells[MAP_W][MAP_H];
     allowed_stair_cells(allowed_cells);
 
+    int dist_to_player[MAP_W][MAP_H];
+    dist_field::chebyshev(map::player->pos, dist_to_player);
+
     std::vector<P> allowed_cells_list;
-    to_vec((bool*)allowed_cells, true, MAP_W, MAP_H, allowed_cells_list);
+    dist_field::sorted_cells(dist_to_player, allowed_cells, allowed_cells_list);
 
     const int NR_OK_CELLS = allowed_cells_list.size();
 
@@ -1226,7 +1352,7 @@ P place_stairs()
     {
         TRACE << "Nr available cells to place stairs too low "
               << "(" << NR_OK_CELLS << "), discarding map" << std:: endl;
-        is_map_valid = false;
+        mk_map_invalid(Map_invalid_reason::place_stairs);
 #ifdef DEMO_MODE
         render::cover_panel(Panel::log);
         render::draw_map();
@@ -1240,11 +1366,6 @@ P place_stairs()
         return P(-1, -1);
     }
 
-    TRACE << "Sorting the allowed cells vector "
-          << "(" << allowed_cells_list.size() << " cells)" << std:: endl;
-    Is_closer_to_pos is_closer_to_origin(map::player->pos);
-    sort(allowed_cells_list.begin(), allowed_cells_list.end(), is_closer_to_origin);
-
     TRACE << "Picking furthest cell" << std:: endl;
     const P stairs_pos(allowed_cells_list[NR_OK_CELLS - 1]);
 
@@ -1262,24 +1383,19 @@ void move_player_to_nearest_allowed_pos()
     bool allowed_cells[MAP_W][MAP_H];
     allowed_stair_cells(allowed_cells);
 
+    int dist_to_player[MAP_W][MAP_H];
+    dist_field::chebyshev(map::player->pos, dist_to_player);
+
     std::vector<P> allowed_cells_list;
-    to_vec((bool*)allowed_cells, true, MAP_W, MAP_H, allowed_cells_list);
+    dist_field::sorted_cells(dist_to_player, allowed_cells, allowed_cells_list);
 
     if (allowed_cells_list.empty())
     {
-        is_map_valid = false;
+        mk_map_invalid(Map_invalid_reason::player_pos);
     }
     else //Valid cells exists
     {
-        TRACE << "Sorting the allowed cells vector "
-              << "(" << allowed_cells_list.size() << " cells)" << std:: endl;
-
-        Is_closer_to_pos is_closer_to_origin(map::player->pos);
-
-        sort(allowed_cells_list.begin(), allowed_cells_list.end(), is_closer_to_origin);
-
         map::player->pos = allowed_cells_list.front();
-
     }
 
     TRACE_FUNC_END;
@@ -1391,27 +1507,33 @@ void reveal_doors_on_path_to_stairs(const P& stairs_pos)
 
 bool mk_std_lvl()
 {
+    PROFILE_ZONE("mapgen::mk_std_lvl");
+
     TRACE_FUNC_BEGIN;
 
-    is_map_valid = true;
+    mk_map_valid();
 
-    render::clear_screen();
-    render::update_screen();
+    {
+        Phase_scope phase_scope(Mapgen_phase::init);
 
-    map::reset_map();
+        render::clear_screen();
+        render::update_screen();
 
-    TRACE << "Resetting helper arrays" << std:: endl;
+        map::reset_map();
 
-    for (int x = 0; x < MAP_W; ++x)
-    {
-        for (int y = 0; y < MAP_H; ++y)
+        TRACE << "Resetting helper arrays" << std:: endl;
+
+        for (int x = 0; x < MAP_W; ++x)
         {
-            door_proposals[x][y] = false;
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                door_proposals[x][y] = false;
+            }
         }
-    }
 
-    //NOTE: This must be called before any rooms are created
-    room_factory::init_room_bucket();
+        //NOTE: This must be called before any rooms are created
+        room_factory::init_room_bucket();
+    }
 
     TRACE << "Init regions" << std:: endl;
     const int MAP_W_THIRD = MAP_W / 3;
@@ -1436,34 +1558,40 @@ bool mk_std_lvl()
         }
     }
 
+    {
+        Phase_scope phase_scope(Mapgen_phase::regions);
+
 #ifdef MK_RIVER
-    const int RIVER_ONE_IN_N = 8;
+        const int RIVER_ONE_IN_N = 8;
 
-    if (
-        is_map_valid                        &&
-        map::dlvl >= DLVL_FIRST_MID_GAME    &&
-        rnd::one_in(RIVER_ONE_IN_N))
-    {
-        reserve_river(regions);
-    }
+        if (
+            is_map_valid                        &&
+            map::dlvl >= DLVL_FIRST_MID_GAME    &&
+            rnd::one_in(RIVER_ONE_IN_N))
+        {
+            reserve_river(regions);
+        }
 #endif //MK_RIVER
 
 #ifdef MK_MERGED_REGIONS
-    if (is_map_valid)
-    {
-        mk_merged_regions_and_rooms(regions);
-    }
+        if (is_map_valid)
+        {
+            mk_merged_regions_and_rooms(regions);
+        }
 #endif //MK_MERGED_REGIONS
 
 #ifdef RANDOMLY_BLOCK_REGIONS
-    if (is_map_valid)
-    {
-        randomly_block_regions(regions);
-    }
+        if (is_map_valid)
+        {
+            randomly_block_regions(regions);
+        }
 #endif //RANDOMLY_BLOCK_REGIONS
+    }
 
     if (is_map_valid)
     {
+        Phase_scope phase_scope(Mapgen_phase::main_rooms);
+
         TRACE << "Making main rooms" << std:: endl;
 
         for (int x = 0; x < 3; ++x)
@@ -1498,6 +1626,8 @@ bool mk_std_lvl()
 #endif //DEMO_MODE
     if (is_map_valid)
     {
+        Phase_scope phase_scope(Mapgen_phase::aux_rooms);
+
         mk_aux_rooms(regions);
     }
 #endif //MK_AUX_ROOMS
@@ -1515,6 +1645,8 @@ bool mk_std_lvl()
         render::update_screen();
         query::wait_for_key_press();
 #endif //DEMO_MODE
+        Phase_scope phase_scope(Mapgen_phase::sub_rooms);
+
         mk_sub_rooms();
     }
 #endif //MK_SUB_ROOMS
@@ -1545,6 +1677,7 @@ bool mk_std_lvl()
         render::update_screen();
         query::wait_for_key_press();
 #endif //DEMO_MODE
+        Phase_scope phase_scope(Mapgen_phase::pre_connect);
 
         gods::set_no_god();
 
@@ -1567,6 +1700,8 @@ bool mk_std_lvl()
         render::update_screen();
         query::wait_for_key_press();
 #endif //DEMO_MODE
+        Phase_scope phase_scope(Mapgen_phase::connect_rooms);
+
         connect_rooms();
     }
 
@@ -1584,6 +1719,7 @@ bool mk_std_lvl()
         render::update_screen();
         query::wait_for_key_press();
 #endif //DEMO_MODE
+        Phase_scope phase_scope(Mapgen_phase::post_connect);
 
         for (Room* room : map::room_list)
         {
@@ -1604,12 +1740,16 @@ bool mk_std_lvl()
         render::update_screen();
         query::wait_for_key_press();
 #endif //DEMO_MODE
+        Phase_scope phase_scope(Mapgen_phase::fill_dead_ends);
+
         fill_dead_ends();
     }
 #endif //FILL_DEAD_ENDS
 
     if (is_map_valid && map::dlvl <= DLVL_LAST_MID_GAME)
     {
+        Phase_scope phase_scope(Mapgen_phase::doors);
+
         TRACE << "Placing doors" << std:: endl;
 
         for (int x = 0; x < MAP_W; ++x)
@@ -1626,28 +1766,27 @@ bool mk_std_lvl()
 
     if (is_map_valid)
     {
+        Phase_scope phase_scope(Mapgen_phase::player_pos);
+
         move_player_to_nearest_allowed_pos();
     }
 
 #ifdef DECORATE
     if (is_map_valid)
     {
+        Phase_scope phase_scope(Mapgen_phase::decorate);
+
         decorate();
     }
 #endif //DECORATE
 
     if (is_map_valid)
     {
-        populate_mon::populate_std_lvl();
-    }
+        Phase_scope phase_scope(Mapgen_phase::populate);
 
-    if (is_map_valid)
-    {
+        //NOTE: Populating never makes the map invalid
+        populate_mon::populate_std_lvl();
         populate_traps::populate_std_lvl();
-    }
-
-    if (is_map_valid)
-    {
         populate_items::mk_items_on_floor();
     }
 
@@ -1655,9 +1794,13 @@ bool mk_std_lvl()
 
     if (is_map_valid)
     {
+        Phase_scope phase_scope(Mapgen_phase::place_stairs);
+
         stairs_pos = place_stairs();
     }
 
+    Phase_scope finalize_phase_scope(Mapgen_phase::finalize);
+
     if (is_map_valid)
     {
         //Occasionally place some snake emerge events
@@ -1703,6 +1846,46 @@ bool mk_std_lvl()
     return is_map_valid;
 }
 
+const Mapgen_phase_stats& phase_stats(const Mapgen_phase phase)
+{
+    ASSERT(phase != Mapgen_phase::END);
+
+    return phase_stats_[size_t(phase)];
+}
+
+void reset_phase_stats()
+{
+    for (Mapgen_phase_stats& stats : phase_stats_)
+    {
+        stats = Mapgen_phase_stats();
+    }
+}
+
+std::string phase_name(const Mapgen_phase phase)
+{
+    switch (phase)
+    {
+    case Mapgen_phase::init:            return "init";
+    case Mapgen_phase::regions:         return "regions";
+    case Mapgen_phase::main_rooms:      return "main_rooms";
+    case Mapgen_phase::aux_rooms:       return "aux_rooms";
+    case Mapgen_phase::sub_rooms:       return "sub_rooms";
+    case Mapgen_phase::pre_connect:     return "pre_connect";
+    case Mapgen_phase::connect_rooms:   return "connect_rooms";
+    case Mapgen_phase::post_connect:    return "post_connect";
+    case Mapgen_phase::fill_dead_ends:  return "fill_dead_ends";
+    case Mapgen_phase::doors:           return "doors";
+    case Mapgen_phase::player_pos:      return "player_pos";
+    case Mapgen_phase::decorate:        return "decorate";
+    case Mapgen_phase::populate:        return "populate";
+    case Mapgen_phase::place_stairs:    return "place_stairs";
+    case Mapgen_phase::finalize:        return "finalize";
+    case Mapgen_phase::END:             break;
+    }
+
+    return "";
+}
+
 } //mapgen
 
 //=============================================================== REGION
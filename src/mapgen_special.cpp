@@ -26,6 +26,8 @@ namespace mapgen
 //------------------------------------------------------------------- FOREST
 bool mk_intro_lvl()
 {
+    mk_map_valid();
+
     map::reset_map();
 
     const Map_templ&    templ       = map_templ_handling::templ(Map_templ_id::intro_forest);
@@ -233,6 +235,8 @@ bool mk_intro_lvl()
 //------------------------------------------------------------------- EGYPT
 bool mk_egypt_lvl()
 {
+    mk_map_valid();
+
     map::reset_map();
 
     const Map_templ&    templ       = map_templ_handling::templ(Map_templ_id::egypt);
@@ -294,6 +298,8 @@ bool mk_egypt_lvl()
 //------------------------------------------------------------------- LENG
 bool mk_leng_lvl()
 {
+    mk_map_valid();
+
     map::reset_map();
 
     const Map_templ&    templ       = map_templ_handling::templ(Map_templ_id::leng);
@@ -370,6 +376,8 @@ bool mk_leng_lvl()
 //------------------------------------------------------------------- RATS IN THE WALLS
 bool mk_rats_in_the_walls_lvl()
 {
+    mk_map_valid();
+
     map::reset_map();
 
     const Map_templ&    templ       = map_templ_handling::templ(Map_templ_id::rats_in_the_walls);
@@ -502,6 +510,8 @@ bool mk_rats_in_the_walls_lvl()
 //------------------------------------------------------------------- BOSS
 bool mk_boss_lvl()
 {
+    mk_map_valid();
+
     map::reset_map();
 
     const Map_templ&    templ       = map_templ_handling::templ(Map_templ_id::boss_level);
@@ -553,6 +563,8 @@ bool mk_boss_lvl()
 //------------------------------------------------------------------- TRAPEZOHEDRON
 bool mk_trapez_lvl()
 {
+    mk_map_valid();
+
     map::reset_map();
 
     const Map_templ&    templ       = map_templ_handling::templ(Map_templ_id::trapez_level);
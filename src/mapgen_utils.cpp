@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <climits>
+#include <algorithm>
 
 #include "init.hpp"
 #include "map.hpp"
@@ -18,6 +19,24 @@ namespace mapgen
 
 bool is_map_valid = true;
 
+Map_invalid_reason invalid_reason = Map_invalid_reason::none;
+
+void mk_map_invalid(const Map_invalid_reason reason)
+{
+    if (is_map_valid)
+    {
+        invalid_reason = reason;
+    }
+
+    is_map_valid = false;
+}
+
+void mk_map_valid()
+{
+    is_map_valid    = true;
+    invalid_reason  = Map_invalid_reason::none;
+}
+
 } //mapgen
 
 namespace mapgen_utils
@@ -293,7 +312,7 @@ void cavify_room(Room& room)
         {
             for (int y = 0; y < MAP_H; ++y)
             {
-                if (flood[x][y] > 0)
+                if (flood[x][y] > 0 && flood[x][y] != flood_fill::unreached)
                 {
                     map::put(new Floor({x, y}));
 
@@ -461,17 +480,20 @@ void mk_path_find_cor(Room& room_0,
 
     TRACE_VERBOSE << "Finding shortest possible dist between entries" << std::endl;
 
-    for (const P& p0 : p0_bucket)
+    //Distance from each cell to the nearest entry of room 1
+    bool is_p1[MAP_W][MAP_H] = {};
+
+    for (const P& p1 : p1_bucket)
     {
-        for (const P& p1 : p1_bucket)
-        {
-            const int DIST = king_dist(p0, p1);
+        is_p1[p1.x][p1.y] = true;
+    }
 
-            if (DIST < shortest_dist)
-            {
-                shortest_dist = DIST;
-            }
-        }
+    int dist_to_p1[MAP_W][MAP_H];
+    dist_field::chebyshev(is_p1, dist_to_p1);
+
+    for (const P& p0 : p0_bucket)
+    {
+        shortest_dist = std::min(shortest_dist, dist_to_p1[p0.x][p0.y]);
     }
 
     TRACE_VERBOSE << "Storing entry pairs with shortest dist (" << shortest_dist << ")"
@@ -481,6 +503,12 @@ void mk_path_find_cor(Room& room_0,
 
     for (const P& p0 : p0_bucket)
     {
+        //Only entries with a nearest entry at the shortest distance can be used
+        if (dist_to_p1[p0.x][p0.y] != shortest_dist)
+        {
+            continue;
+        }
+
         for (const P& p1 : p1_bucket)
         {
             const int DIST = king_dist(p0, p1);
@@ -563,16 +591,42 @@ void mk_path_find_cor(Room& room_0,
         //Allowing diagonal steps creates a more "cave like" path
         const bool ALLOW_DIAGONAL = map::dlvl >= DLVL_FIRST_LATE_GAME;
 
-        //Randomizing steps create more "snaky" paths
-        const bool RANDOMIZE_STEP_CHOICES = map::dlvl >= DLVL_FIRST_LATE_GAME ? true :
-                                            rnd::one_in(5);
+        //Randomizing the step costs create more "snaky" paths
+        const bool RANDOMIZE_STEP_COSTS = map::dlvl >= DLVL_FIRST_LATE_GAME ? true :
+                                          rnd::one_in(5);
+
+        //The step cost of each cell (1 to 3) is derived from one random number
+        //by hashing, instead of drawing a random number for every cell
+        const unsigned int SEED = RANDOMIZE_STEP_COSTS ? rnd::range(0, 1 << 30) : 0;
+
+        int cost[MAP_W][MAP_H];
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                if (blocked_expanded[x][y])
+                {
+                    cost[x][y] = 0;
+                }
+                else if (RANDOMIZE_STEP_COSTS)
+                {
+                    unsigned int h = SEED ^ (unsigned(x) * 73856093u) ^ (unsigned(y) * 19349663u);
+
+                    h ^= h >> 13;
+                    h *= 0x5bd1e995u;
+                    h ^= h >> 15;
+
+                    cost[x][y] = 1 + int(h % 3);
+                }
+                else
+                {
+                    cost[x][y] = 1;
+                }
+            }
+        }
 
-        path_find::run(p0,
-                       p1,
-                       blocked_expanded,
-                       path,
-                       ALLOW_DIAGONAL,
-                       RANDOMIZE_STEP_CHOICES);
+        a_star::run(p0, p1, cost, path, ALLOW_DIAGONAL);
     }
 
     if (!path.empty())
@@ -703,7 +757,7 @@ void pathfinder_walk(const P& p0,
     bool blocked[MAP_W][MAP_H] = {};
 
     std::vector<P> path;
-    path_find::run(p0, p1, blocked, path);
+    a_star::run(p0, p1, blocked, path);
 
     std::vector<P> rnd_walk_buffer;
 
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_set>
 
 #include "init.hpp"
 #include "input.hpp"
@@ -17,10 +18,100 @@ namespace msg_log
 namespace
 {
 
+const size_t max_nr_history_lines  = 300;
+
+//When there are more interned strings than this, the strings no longer used by
+//any message are removed
+const size_t max_nr_interned_strs  = 2048;
+
 std::vector<Msg>                lines_[2];
-std::vector< std::vector<Msg> > history_;
 const std::string               more_str = "-More-";
 
+//The history is a ring buffer - when it is full, the oldest line is overwritten
+//(reusing the memory of that line)
+std::vector< std::vector<Msg> > history_;
+size_t                          history_begin_  = 0;
+size_t                          history_size_   = 0;
+
+//NOTE: The elements of an unordered set are never moved, so the string addresses
+//stay valid as more strings are added
+std::unordered_set<std::string> interned_strs_;
+
+std::vector<Msg>& history_line_at(const size_t IDX)
+{
+    ASSERT(IDX < history_size_);
+
+    return history_[(history_begin_ + IDX) % max_nr_history_lines];
+}
+
+//Returns a new (empty) history line, removing the oldest line if full
+std::vector<Msg>& push_history_line()
+{
+    if (history_.size() < max_nr_history_lines)
+    {
+        history_.resize(max_nr_history_lines);
+    }
+
+    if (history_size_ == max_nr_history_lines)
+    {
+        history_begin_ = (history_begin_ + 1) % max_nr_history_lines;
+    }
+    else //Not full
+    {
+        ++history_size_;
+    }
+
+    std::vector<Msg>& line = history_line_at(history_size_ - 1);
+
+    line.clear();
+
+    return line;
+}
+
+void compact_interned_strs()
+{
+    std::unordered_set<std::string> used_strs;
+
+    auto reintern = [&](std::vector<Msg>& line)
+    {
+        for (Msg& msg : line)
+        {
+            const std::string* const str = &*used_strs.insert(*msg.interned_str()).first;
+
+            msg.set_interned_str(str);
+        }
+    };
+
+    for (std::vector<Msg>& line : lines_)
+    {
+        reintern(line);
+    }
+
+    for (size_t i = 0; i < history_size_; ++i)
+    {
+        reintern(history_line_at(i));
+    }
+
+    interned_strs_.swap(used_strs);
+}
+
+const std::string* intern(const std::string& str)
+{
+    auto it = interned_strs_.find(str);
+
+    if (it != end(interned_strs_))
+    {
+        return &*it;
+    }
+
+    if (interned_strs_.size() >= max_nr_interned_strs)
+    {
+        compact_interned_strs();
+    }
+
+    return &*interned_strs_.insert(str).first;
+}
+
 int x_after_msg(const Msg* const msg)
 {
     if (!msg)
@@ -59,6 +150,11 @@ void init()
     }
 
     history_.clear();
+
+    history_begin_  = 0;
+    history_size_   = 0;
+
+    interned_strs_.clear();
 }
 
 void clear()
@@ -67,12 +163,7 @@ void clear()
     {
         if (!line.empty())
         {
-            history_.push_back(line);
-
-            while (history_.size() > 300)
-            {
-                history_.erase(history_.begin());
-            }
+            push_history_line() = line;
 
             line.clear();
         }
@@ -109,6 +200,9 @@ void add(const std::string& str,
 {
     ASSERT(!str.empty());
 
+    //Messages end fast-forwarding, so that they are shown with the current map
+    render::set_fast_forward(false);
+
 #ifndef NDEBUG
     if (str[0] == ' ')
     {
@@ -119,6 +213,8 @@ void add(const std::string& str,
 
     int cur_line_nr = lines_[1].empty() ? 0 : 1;
 
+    Msg msg(str, clr, 0);
+
     Msg* prev_msg = nullptr;
 
     if (!lines_[cur_line_nr].empty())
@@ -129,16 +225,12 @@ void add(const std::string& str,
     bool is_repeated = false;
 
     //Check if message is identical to previous
-    if (add_more_prompt_on_msg == More_prompt_on_msg::no && prev_msg)
+    if (add_more_prompt_on_msg == More_prompt_on_msg::no &&
+        prev_msg                                         &&
+        prev_msg->is_same_str(msg))
     {
-        std::string prev_str = "";
-        prev_msg->str_raw(prev_str);
-
-        if (prev_str.compare(str) == 0)
-        {
-            prev_msg->incr_repeat();
-            is_repeated = true;
-        }
+        prev_msg->incr_repeat();
+        is_repeated = true;
     }
 
     if (!is_repeated)
@@ -167,7 +259,9 @@ void add(const std::string& str,
             x_pos = 0;
         }
 
-        lines_[cur_line_nr].push_back(Msg(str, clr, x_pos));
+        msg.x_pos_ = x_pos;
+
+        lines_[cur_line_nr].push_back(msg);
     }
 
     if (add_more_prompt_on_msg == More_prompt_on_msg::yes)
@@ -232,7 +326,7 @@ void display_history()
     clear();
 
     const int LINE_JUMP           = 3;
-    const int NR_LINES_TOT        = history_.size();
+    const int NR_LINES_TOT        = history_size_;
     const int MAX_NR_LINES_ON_SCR = SCREEN_H - 2;
 
     int top_nr = std::max(0, NR_LINES_TOT - MAX_NR_LINES_ON_SCR);
@@ -244,7 +338,7 @@ void display_history()
 
         std::string title = "";
 
-        if (history_.empty())
+        if (history_size_ == 0)
         {
             title = "No message history";
         }
@@ -255,7 +349,7 @@ void display_history()
 
             title = "Messages " +
                     msg_nr_first + "-" + msg_nr_last +
-                    " of " + to_str(history_.size());
+                    " of " + to_str(history_size_);
         }
 
         render::draw_info_scr_interface(title, Inf_screen_type::scrolling);
@@ -264,7 +358,7 @@ void display_history()
 
         for (int i = top_nr; i <= btm_nr; ++i)
         {
-            draw_line(history_[i], y_pos++);
+            draw_line(history_line_at(i), y_pos++);
         }
 
         render::update_screen();
@@ -301,14 +395,29 @@ void display_history()
 
 void add_line_to_history(const std::string& line_to_add)
 {
-    std::vector<Msg> history_line;
-    history_line.push_back(Msg(line_to_add, clr_white, 0));
-    history_.push_back(history_line);
+    push_history_line().push_back(Msg(line_to_add, clr_white, 0));
 }
 
-const std::vector< std::vector<Msg> >& history()
+int history_size()
 {
-    return history_;
+    return history_size_;
+}
+
+const std::vector<Msg>& history_line(const int IDX)
+{
+    return history_line_at(IDX);
 }
 
 } //msg_log
+
+Msg::Msg(const std::string& text, const Clr& clr, const int X_POS) :
+    clr_    (clr),
+    x_pos_  (X_POS),
+    str_    (msg_log::intern(text)),
+    nr_     (1) {}
+
+Msg::Msg() :
+    clr_    (clr_white),
+    x_pos_  (0),
+    str_    (msg_log::intern("")),
+    nr_     (1) {}
@@ -11,6 +11,43 @@
 namespace populate_items
 {
 
+namespace
+{
+
+//Including the final special levels
+const int nr_dlvls = DLVL_LAST + 3;
+
+//Items which may spawn on the floor at each dungeon level, in item data order.
+//These only depend on the static item data - the spawn permission and the
+//chance to include each item are checked when spawning.
+std::vector<Item_id> floor_spawn_ids_[nr_dlvls];
+
+} //namespace
+
+void init()
+{
+    for (int dlvl = 0; dlvl < nr_dlvls; ++dlvl)
+    {
+        std::vector<Item_id>& ids = floor_spawn_ids_[dlvl];
+
+        ids.clear();
+
+        for (int i = 0; i < int(Item_id::END); ++i)
+        {
+            const Item_data_t& data = item_data::data[i];
+
+            //Intrinsic items, and items with a dlvl range not matching the
+            //dlvl are not allowed to spawn on the floor
+            if (
+                int(data.type) < int(Item_type::END_OF_EXTR_ITEMS) &&
+                data.spawn_std_range.is_in_range(dlvl))
+            {
+                ids.push_back(Item_id(i));
+            }
+        }
+    }
+}
+
 void mk_items_on_floor()
 {
     int nr_spawns = rnd::range(4, 5);
@@ -20,25 +57,21 @@ void mk_items_on_floor()
         nr_spawns += 2;
     }
 
+    ASSERT(map::dlvl >= 0 && map::dlvl < nr_dlvls);
+
     std::vector<Item_id> item_bucket;
-    item_bucket.clear();
 
-    for (int i = 0; i < int(Item_id::END); ++i)
+    for (const Item_id id : floor_spawn_ids_[map::dlvl])
     {
-        const Item_data_t& data = item_data::data[i];
-
-        //The following items are NOT allowed to spawn on the floor:
-        // * Intrinsic items
-        // * Items with a dlvl range not matching current dlvl
-        // * Items forbidden to spawn (e.g. unique items already spawned)
+        const Item_data_t& data = item_data::data[size_t(id)];
 
+        //Items forbidden to spawn (e.g. unique items already spawned) are
+        //not allowed
         if (
-            int(data.type) < int(Item_type::END_OF_EXTR_ITEMS)      &&
-            data.spawn_std_range.is_in_range(map::dlvl)             &&
-            data.allow_spawn                                        &&
+            data.allow_spawn &&
             rnd::percent(data.chance_to_incl_in_floor_spawn_list))
         {
-            item_bucket.push_back(Item_id(i));
+            item_bucket.push_back(id);
         }
     }
 
@@ -18,6 +18,11 @@ namespace populate_mon
 namespace
 {
 
+//Monsters which may auto spawn at each (effective) dungeon level, in actor data
+//order. These only depend on the static actor data - the spawn limits and
+//uniques already on the level are checked when picking monsters.
+std::vector<Actor_id> auto_spawn_ids_[DLVL_LAST + 1];
+
 int random_out_of_depth()
 {
     if (map::dlvl == 0)
@@ -46,30 +51,32 @@ void mk_list_of_mon_can_auto_spawn(const int NR_LVLS_OUT_OF_DEPTH,
     const int EFFECTIVE_DLVL =
         constr_in_range(1, map::dlvl + NR_LVLS_OUT_OF_DEPTH, DLVL_LAST);
 
-    //Get list of actors currently on the level (to help avoid spawning multiple uniques,
-    //note that this could otherwise happen for example with Zuul - he is allowed to
-    //spawn freely after he appears from a possessed Cultist priest)
-    bool spawned_ids[size_t(Actor_id::END)];
-
-    for (bool& v : spawned_ids) {v = false;}
-
-    for (const auto* const actor : game_time::actors)
+    for (const Actor_id id : auto_spawn_ids_[EFFECTIVE_DLVL])
     {
-        spawned_ids[size_t(actor->id())] = true;
-    }
+        const Actor_data_t& d = actor_data::data[size_t(id)];
 
-    for (const auto& d : actor_data::data)
-    {
-        if (
-            d.id != Actor_id::player            &&
-            d.is_auto_spawn_allowed             &&
-            d.nr_left_allowed_to_spawn != 0     &&
-            EFFECTIVE_DLVL >= d.spawn_min_dlvl  &&
-            EFFECTIVE_DLVL <= d.spawn_max_dlvl  &&
-            !(d.is_unique && spawned_ids[size_t(d.id)]))
+        if (d.nr_left_allowed_to_spawn == 0)
+        {
+            continue;
+        }
+
+        //Avoid spawning multiple uniques (this could otherwise happen for example
+        //with Zuul - he is allowed to spawn freely after he appears from a
+        //possessed Cultist priest)
+        if (d.is_unique)
         {
-            list_ref.push_back(d.id);
+            const auto is_same_id = [id](const Actor* const actor)
+            {
+                return actor->id() == id;
+            };
+
+            if (std::any_of(begin(game_time::actors), end(game_time::actors), is_same_id))
+            {
+                continue;
+            }
         }
+
+        list_ref.push_back(id);
     }
 }
 
@@ -208,31 +215,51 @@ void mk_sorted_free_cells(const P& origin,
                           const bool blocked[MAP_W][MAP_H],
                           std::vector<P>& vector_ref)
 {
-    vector_ref.clear();
-
     const int RADI = 10;
-    const int X0 = constr_in_range(1, origin.x - RADI, MAP_W - 2);
-    const int Y0 = constr_in_range(1, origin.y - RADI, MAP_H - 2);
-    const int X1 = constr_in_range(1, origin.x + RADI, MAP_W - 2);
-    const int Y1 = constr_in_range(1, origin.y + RADI, MAP_H - 2);
+
+    //Only the cells within the radius are checked
+    const int X0 = std::max(1,          origin.x - RADI);
+    const int Y0 = std::max(1,          origin.y - RADI);
+    const int X1 = std::min(MAP_W - 2,  origin.x + RADI);
+    const int Y1 = std::min(MAP_H - 2,  origin.y + RADI);
+
+    bool is_free[MAP_W][MAP_H] = {};
 
     for (int x = X0; x <= X1; ++x)
     {
         for (int y = Y0; y <= Y1; ++y)
         {
-            if (!blocked[x][y])
-            {
-                vector_ref.push_back(P(x, y));
-            }
+            is_free[x][y] = !blocked[x][y];
         }
     }
 
-    Is_closer_to_pos sorter(origin);
-    std::sort(vector_ref.begin(), vector_ref.end(), sorter);
+    dist_field::sorted_cells_near(origin, is_free, vector_ref, RADI);
 }
 
 } //namespace
 
+void init()
+{
+    for (int dlvl = 0; dlvl <= DLVL_LAST; ++dlvl)
+    {
+        std::vector<Actor_id>& ids = auto_spawn_ids_[dlvl];
+
+        ids.clear();
+
+        for (const auto& d : actor_data::data)
+        {
+            if (
+                d.id != Actor_id::player    &&
+                d.is_auto_spawn_allowed     &&
+                dlvl >= d.spawn_min_dlvl    &&
+                dlvl <= d.spawn_max_dlvl)
+            {
+                ids.push_back(d.id);
+            }
+        }
+    }
+}
+
 void try_spawn_due_to_time_passed()
 {
     TRACE_FUNC_BEGIN;
@@ -278,7 +305,7 @@ void try_spawn_due_to_time_passed()
     if (!free_cells_vector.empty())
     {
         const int   ELEMENT = rnd::range(0, free_cells_vector.size() - 1);
-        const P&    origin  = free_cells_vector[ELEMENT];
+        const P     origin  = free_cells_vector[ELEMENT];
 
         mk_sorted_free_cells(origin, blocked, free_cells_vector);
 
@@ -171,18 +171,18 @@ void mk_info_lines(std::vector<Str_and_clr>& out)
 
     out.push_back({"", clr_info});
     out.push_back({"Last messages:", clr_heading});
-    const std::vector< std::vector<Msg> >& history = msg_log::history();
+    const int NR_HISTORY_LINES = msg_log::history_size();
 
-    int history_element = std::max(0, int(history.size()) - 20);
+    const int HISTORY_ELEMENT = std::max(0, NR_HISTORY_LINES - 20);
 
-    for (size_t i = history_element; i < history.size(); ++i)
+    for (int i = HISTORY_ELEMENT; i < NR_HISTORY_LINES; ++i)
     {
         std::string row = "";
 
-        for (size_t ii = 0; ii < history[i].size(); ii++)
+        for (const Msg& msg : msg_log::history_line(i))
         {
             std::string msg_str = "";
-            history[i][ii].str_with_repeats(msg_str);
+            msg.str_with_repeats(msg_str);
             row += msg_str + " ";
         }
 
@@ -0,0 +1,215 @@
+#include "profiler.hpp"
+
+#ifdef PROFILING
+
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+#include <SDL.h>
+
+#include "init.hpp"
+#include "rl_utils.hpp"
+
+namespace profiler
+{
+
+namespace
+{
+
+const std::string trace_file_name = "profile_trace.json";
+
+//Limits the memory used by long sessions - later zones are dropped
+const size_t max_nr_events_per_thread = 2000000;
+
+struct Event
+{
+    const char* name;
+    std::string detail;
+    int64_t     start_us;
+    int64_t     dur_us;
+};
+
+struct Thread_events
+{
+    SDL_threadID        thread_id;
+    std::vector<Event>  events;
+    size_t              nr_dropped;
+};
+
+std::chrono::steady_clock::time_point start_time_;
+
+//Each thread records into its own buffer, the mutex only guards the list of
+//buffers (and is only locked the first time a thread records anything)
+SDL_mutex* mutex_ = nullptr;
+
+std::vector<Thread_events*> all_thread_events_;
+
+thread_local Thread_events* thread_events_ = nullptr;
+
+Thread_events& cur_thread_events()
+{
+    if (!thread_events_)
+    {
+        thread_events_              = new Thread_events;
+        thread_events_->thread_id   = SDL_ThreadID();
+        thread_events_->nr_dropped  = 0;
+
+        SDL_LockMutex(mutex_);
+        all_thread_events_.push_back(thread_events_);
+        SDL_UnlockMutex(mutex_);
+    }
+
+    return *thread_events_;
+}
+
+int64_t us_since_start(const std::chrono::steady_clock::time_point& t)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - start_time_).count();
+}
+
+std::string escaped(const std::string& str)
+{
+    std::string ret;
+
+    ret.reserve(str.size());
+
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            ret += '\\';
+        }
+
+        ret += c;
+    }
+
+    return ret;
+}
+
+void write_trace()
+{
+    std::ofstream file(trace_file_name);
+
+    if (!file.is_open())
+    {
+        TRACE << "Failed to open " << trace_file_name << std::endl;
+        return;
+    }
+
+    file << "{\"traceEvents\":[" << std::endl;
+
+    bool is_first = true;
+
+    for (const Thread_events* const thread_events : all_thread_events_)
+    {
+        if (thread_events->nr_dropped > 0)
+        {
+            TRACE << "Profiler dropped " << thread_events->nr_dropped
+                  << " zones (buffer full)" << std::endl;
+        }
+
+        for (const Event& e : thread_events->events)
+        {
+            if (!is_first)
+            {
+                file << "," << std::endl;
+            }
+
+            is_first = false;
+
+            file << "{\"name\":\""  << escaped(e.name)   << "\","
+                 << "\"ph\":\"X\","
+                 << "\"pid\":1,"
+                 << "\"tid\":"      << thread_events->thread_id << ","
+                 << "\"ts\":"       << e.start_us << ","
+                 << "\"dur\":"      << e.dur_us;
+
+            if (!e.detail.empty())
+            {
+                file << ",\"args\":{\"detail\":\"" << escaped(e.detail) << "\"}";
+            }
+
+            file << "}";
+        }
+    }
+
+    file << std::endl << "]}" << std::endl;
+
+    TRACE << "Wrote profiling trace to " << trace_file_name << std::endl;
+}
+
+} //namespace
+
+void init()
+{
+    TRACE_FUNC_BEGIN;
+
+    start_time_ = std::chrono::steady_clock::now();
+
+    if (!mutex_)
+    {
+        mutex_ = SDL_CreateMutex();
+    }
+
+    TRACE_FUNC_END;
+}
+
+void cleanup()
+{
+    TRACE_FUNC_BEGIN;
+
+    write_trace();
+
+    for (Thread_events* const thread_events : all_thread_events_)
+    {
+        //The owning threads may still hold a pointer to the buffer, so only
+        //clear it (the buffers are reused if profiling continues)
+        thread_events->events.clear();
+        thread_events->nr_dropped = 0;
+    }
+
+    TRACE_FUNC_END;
+}
+
+Zone::Zone(const char* const name) :
+    name_   (name),
+    detail_ (),
+    start_  (std::chrono::steady_clock::now()) {}
+
+Zone::Zone(const char* const name, const std::string& detail) :
+    name_   (name),
+    detail_ (detail),
+    start_  (std::chrono::steady_clock::now()) {}
+
+Zone::~Zone()
+{
+    const auto end = std::chrono::steady_clock::now();
+
+    if (!mutex_)
+    {
+        //Not initialized
+        return;
+    }
+
+    Thread_events& thread_events = cur_thread_events();
+
+    if (thread_events.events.size() >= max_nr_events_per_thread)
+    {
+        ++thread_events.nr_dropped;
+        return;
+    }
+
+    Event e;
+
+    e.name      = name_;
+    e.detail    = detail_;
+    e.start_us  = us_since_start(start_);
+    e.dur_us    = std::chrono::duration_cast<std::chrono::microseconds>(end - start_).count();
+
+    thread_events.events.push_back(e);
+}
+
+} //profiler
+
+#endif //PROFILING
@@ -2,6 +2,12 @@
 
 #include <vector>
 #include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include <sys/stat.h>
 
 #include "init.hpp"
 #include "item.hpp"
@@ -18,6 +24,8 @@
 #include "inventory.hpp"
 #include "sdl_wrapper.hpp"
 #include "text_format.hpp"
+#include "profiler.hpp"
+#include "gas.hpp"
 
 namespace render
 {
@@ -37,6 +45,12 @@ SDL_Texture*    scr_texture_        = nullptr;
 SDL_Surface*    main_menu_logo_srf_ = nullptr;
 SDL_Surface*    skull_srf_          = nullptr;
 
+//Font and tile sheets on the GPU, used for hardware accelerated map drawing
+SDL_Texture*    font_texture_           = nullptr;
+SDL_Texture*    font_contour_texture_   = nullptr;
+SDL_Texture*    tile_texture_           = nullptr;
+SDL_Texture*    tile_contour_texture_   = nullptr;
+
 const size_t PIXEL_DATA_W = 400;
 const size_t PIXEL_DATA_H = 400;
 
@@ -46,11 +60,138 @@ bool font_px_data_[PIXEL_DATA_W][PIXEL_DATA_H];
 bool tile_contour_px_data_[PIXEL_DATA_W][PIXEL_DATA_H];
 bool font_contour_px_data_[PIXEL_DATA_W][PIXEL_DATA_H];
 
+//The pixel data and contour of each image is cached as packed bits in the data
+//directory, so that the images are only decoded and scanned when they change
+const std::string   px_cache_file_prefix    = "data/px_cache_";
+const char          px_cache_magic[4]       = {'I', 'A', 'P', 'X'};
+const int32_t       px_cache_version        = 1;
+const size_t        px_cache_packed_size    = (PIXEL_DATA_W * PIXEL_DATA_H + 7) / 8;
+
+//Describes the image (and cell size) which the cached data was made from - if
+//any of this differs, the cache is rebuilt
+struct Px_cache_header
+{
+    char    magic[4];
+    int32_t version;
+    int32_t cell_px_w;
+    int32_t cell_px_h;
+    int64_t img_size;
+    int64_t img_mtime;
+};
+
+//Retained state from previous frames. All drawing primitives flag the screen
+//cells they touch as dirty, and only dirty cells are compared against the
+//presented pixels and uploaded. Map cells drawn by draw_map() remember what
+//they were drawn with, so that unchanged cells are skipped entirely - until
+//something else draws over them.
+bool                is_scr_cell_dirty_[SCREEN_W][SCREEN_H];
+bool                is_map_cell_retained_[MAP_W][MAP_H];
+Cell_render_data    retained_map_cells_[MAP_W][MAP_H];
+
+std::vector<Uint32> presented_px_;
+
+bool                is_full_upload_needed_  = true;
+
+//When drawing the map with hardware acceleration, map cells are left
+//transparent on the screen surface, and the renderer draws the retained cells
+//underneath it instead
+bool                is_hw_map_drawing_      = false;
+bool                is_hw_map_cell_[MAP_W][MAP_H];
+
+//Frame cost counters, reported and reset on each screen update
+int                 nr_map_cells_drawn_     = 0;
+int                 nr_px_uploaded_         = 0;
+
+bool                is_fast_forwarding_     = false;
+
 bool is_inited()
 {
     return sdl_window_;
 }
 
+void mark_px_area_dirty(const P& px_pos, const P& px_dims)
+{
+    if (px_dims.x <= 0 || px_dims.y <= 0)
+    {
+        return;
+    }
+
+    const int CELL_PX_W = config::cell_px_w();
+    const int CELL_PX_H = config::cell_px_h();
+
+    const int X0 = std::max(0,              px_pos.x / CELL_PX_W);
+    const int Y0 = std::max(0,              px_pos.y / CELL_PX_H);
+    const int X1 = std::min(SCREEN_W - 1,   (px_pos.x + px_dims.x - 1) / CELL_PX_W);
+    const int Y1 = std::min(SCREEN_H - 1,   (px_pos.y + px_dims.y - 1) / CELL_PX_H);
+
+    for (int x = X0; x <= X1; ++x)
+    {
+        for (int y = Y0; y <= Y1; ++y)
+        {
+            is_scr_cell_dirty_[x][y] = true;
+
+            const int MAP_Y = y - MAP_OFFSET_H;
+
+            if (MAP_Y >= 0 && MAP_Y < MAP_H)
+            {
+                is_map_cell_retained_[x][MAP_Y] = false;
+            }
+        }
+    }
+}
+
+void reset_retained_state()
+{
+    for (int x = 0; x < SCREEN_W; ++x)
+    {
+        for (int y = 0; y < SCREEN_H; ++y)
+        {
+            is_scr_cell_dirty_[x][y] = false;
+        }
+    }
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            is_map_cell_retained_[x][y] = false;
+            is_hw_map_cell_[x][y]       = false;
+        }
+    }
+
+    is_full_upload_needed_ = true;
+}
+
+//Copies the pixels of a screen cell to the presented pixels, returns true if
+//they were different (i.e. if the cell needs to be uploaded)
+bool cpy_presented_cell_px(const P& cell_pos)
+{
+    const int       CELL_PX_W   = config::cell_px_w();
+    const int       CELL_PX_H   = config::cell_px_h();
+    const int       SCR_PX_W    = config::scr_px_w();
+    const size_t    ROW_BYTES   = CELL_PX_W * sizeof(Uint32);
+    const P         px_p0(cell_pos.x * CELL_PX_W, cell_pos.y * CELL_PX_H);
+
+    bool is_changed = false;
+
+    for (int px_y = px_p0.y; px_y < px_p0.y + CELL_PX_H; ++px_y)
+    {
+        const Uint8* const srf_row = (const Uint8*)scr_srf_->pixels +
+                                     px_y * scr_srf_->pitch +
+                                     px_p0.x * sizeof(Uint32);
+
+        Uint32* const presented_row = &presented_px_[(px_y * SCR_PX_W) + px_p0.x];
+
+        if (memcmp(srf_row, presented_row, ROW_BYTES) != 0)
+        {
+            memcpy(presented_row, srf_row, ROW_BYTES);
+            is_changed = true;
+        }
+    }
+
+    return is_changed;
+}
+
 Uint32 px(SDL_Surface& srf,
           const int PIXEL_X,
           const int PIXEL_Y)
@@ -138,6 +279,8 @@ void blit_surface(SDL_Surface& srf, const P& px_pos)
     };
 
     SDL_BlitSurface(&srf, nullptr, scr_srf_, &dst_rect);
+
+    mark_px_area_dirty(px_pos, P(srf.w, srf.h));
 }
 
 void load_pictures()
@@ -165,50 +308,28 @@ void load_pictures()
     TRACE_FUNC_END;
 }
 
-void load_font()
+void load_img_px_data(const std::string& img_name,
+                      bool out[PIXEL_DATA_W][PIXEL_DATA_H])
 {
-    TRACE_FUNC_BEGIN;
-
-    SDL_Surface* font_srf_tmp = IMG_Load(config::font_name().data());
+    std::fill_n(&out[0][0], PIXEL_DATA_W * PIXEL_DATA_H, false);
 
-    Uint32 img_clr = SDL_MapRGB(font_srf_tmp->format, 255, 255, 255);
+    SDL_Surface* srf_tmp = IMG_Load(img_name.data());
 
-    for (int x = 0; x < font_srf_tmp->w; ++x)
-    {
-        for (int y = 0; y < font_srf_tmp->h; ++y)
-        {
-            const bool IS_IMG_PX = px(*font_srf_tmp, x, y) == img_clr;
-
-            font_px_data_[x][y] = IS_IMG_PX;
-        }
-    }
+    ASSERT(srf_tmp && "Failed to load image");
 
-    SDL_FreeSurface(font_srf_tmp);
+    Uint32 img_clr = SDL_MapRGB(srf_tmp->format, 255, 255, 255);
 
-    TRACE_FUNC_END;
-}
-
-void load_tiles()
-{
-    TRACE_FUNC_BEGIN;
-
-    SDL_Surface* tile_srf_tmp = IMG_Load(tiles_img_name.data());
-
-    Uint32 img_clr = SDL_MapRGB(tile_srf_tmp->format, 255, 255, 255);
-
-    for (int x = 0; x < tile_srf_tmp->w; ++x)
+    for (int x = 0; x < srf_tmp->w; ++x)
     {
-        for (int y = 0; y < tile_srf_tmp->h; ++y)
+        for (int y = 0; y < srf_tmp->h; ++y)
         {
-            const bool IS_IMG_PX = px(*tile_srf_tmp, x, y) == img_clr;
+            const bool IS_IMG_PX = px(*srf_tmp, x, y) == img_clr;
 
-            tile_px_data_[x][y] = IS_IMG_PX;
+            out[x][y] = IS_IMG_PX;
         }
     }
 
-    SDL_FreeSurface(tile_srf_tmp);
-
-    TRACE_FUNC_END;
+    SDL_FreeSurface(srf_tmp);
 }
 
 void load_contour(const bool base[PIXEL_DATA_W][PIXEL_DATA_H],
@@ -258,6 +379,246 @@ void load_contour(const bool base[PIXEL_DATA_W][PIXEL_DATA_H],
     }
 }
 
+std::string px_cache_file_name(const std::string& img_name)
+{
+    std::string file_name = px_cache_file_prefix + img_name;
+
+    std::replace(begin(file_name) + px_cache_file_prefix.size(), end(file_name), '/', '_');
+
+    return file_name;
+}
+
+//Returns false if the image file could not be found
+bool mk_px_cache_header(const std::string& img_name, Px_cache_header& out)
+{
+    struct stat img_stat;
+
+    if (stat(img_name.c_str(), &img_stat) != 0)
+    {
+        return false;
+    }
+
+    memset(&out, 0, sizeof(out));
+
+    memcpy(out.magic, px_cache_magic, sizeof(out.magic));
+
+    out.version     = px_cache_version;
+    out.cell_px_w   = config::cell_px_w();
+    out.cell_px_h   = config::cell_px_h();
+    out.img_size    = img_stat.st_size;
+    out.img_mtime   = img_stat.st_mtime;
+
+    return true;
+}
+
+void pack_px_data(const bool px_data[PIXEL_DATA_W][PIXEL_DATA_H], std::vector<char>& out)
+{
+    out.assign(px_cache_packed_size, 0);
+
+    const bool* const bits = &px_data[0][0];
+
+    for (size_t i = 0; i < PIXEL_DATA_W * PIXEL_DATA_H; ++i)
+    {
+        if (bits[i])
+        {
+            out[i / 8] |= char(1 << (i % 8));
+        }
+    }
+}
+
+void unpack_px_data(const char* const packed, bool out[PIXEL_DATA_W][PIXEL_DATA_H])
+{
+    bool* const bits = &out[0][0];
+
+    for (size_t i = 0; i < PIXEL_DATA_W * PIXEL_DATA_H; ++i)
+    {
+        bits[i] = (packed[i / 8] >> (i % 8)) & 1;
+    }
+}
+
+//Returns false if there is no cached data for this version of the image
+bool load_px_cache(const std::string& img_name,
+                   const Px_cache_header& header,
+                   bool px_data[PIXEL_DATA_W][PIXEL_DATA_H],
+                   bool contour_px_data[PIXEL_DATA_W][PIXEL_DATA_H])
+{
+    std::ifstream file(px_cache_file_name(img_name), std::ios::binary);
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    //Read the whole file at once
+    std::vector<char> buffer(sizeof(Px_cache_header) + 2 * px_cache_packed_size);
+
+    file.read(buffer.data(), buffer.size());
+
+    if (size_t(file.gcount()) != buffer.size())
+    {
+        return false;
+    }
+
+    if (memcmp(buffer.data(), &header, sizeof(Px_cache_header)) != 0)
+    {
+        //Cache was made from another version of the image (or another cell size)
+        return false;
+    }
+
+    const char* const packed = buffer.data() + sizeof(Px_cache_header);
+
+    unpack_px_data(packed,                          px_data);
+    unpack_px_data(packed + px_cache_packed_size,   contour_px_data);
+
+    return true;
+}
+
+void save_px_cache(const std::string& img_name,
+                   const Px_cache_header& header,
+                   const bool px_data[PIXEL_DATA_W][PIXEL_DATA_H],
+                   const bool contour_px_data[PIXEL_DATA_W][PIXEL_DATA_H])
+{
+    std::ofstream file(px_cache_file_name(img_name), std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        TRACE << "Failed to write pixel cache for " << img_name << std::endl;
+        return;
+    }
+
+    std::vector<char> packed;
+
+    file.write((const char*)&header, sizeof(Px_cache_header));
+
+    pack_px_data(px_data, packed);
+
+    file.write(packed.data(), packed.size());
+
+    pack_px_data(contour_px_data, packed);
+
+    file.write(packed.data(), packed.size());
+}
+
+//Loads the pixel data of the image and its contour, from the cache if possible
+void load_px_data(const std::string& img_name,
+                  bool px_data[PIXEL_DATA_W][PIXEL_DATA_H],
+                  bool contour_px_data[PIXEL_DATA_W][PIXEL_DATA_H])
+{
+    TRACE_FUNC_BEGIN;
+
+    Px_cache_header header;
+
+    const bool IS_CACHEABLE = mk_px_cache_header(img_name, header);
+
+    if (IS_CACHEABLE && load_px_cache(img_name, header, px_data, contour_px_data))
+    {
+        TRACE_FUNC_END;
+        return;
+    }
+
+    TRACE << "No pixel cache for " << img_name << ", loading image" << std::endl;
+
+    load_img_px_data(img_name, px_data);
+
+    load_contour(px_data, contour_px_data);
+
+    if (IS_CACHEABLE)
+    {
+        save_px_cache(img_name, header, px_data, contour_px_data);
+    }
+
+    TRACE_FUNC_END;
+}
+
+//Creates a white texture with the marked pixels opaque and the rest fully
+//transparent, so that it can be drawn in any color through color modulation
+SDL_Texture* mk_texture(const bool px_data[PIXEL_DATA_W][PIXEL_DATA_H])
+{
+    SDL_Surface* srf = SDL_CreateRGBSurface(0,
+                                            PIXEL_DATA_W, PIXEL_DATA_H,
+                                            SCREEN_BPP,
+                                            0x00FF0000,
+                                            0x0000FF00,
+                                            0x000000FF,
+                                            0xFF000000);
+
+    if (!srf)
+    {
+        return nullptr;
+    }
+
+    const Uint32 px_set     = SDL_MapRGBA(srf->format, 255, 255, 255, 255);
+    const Uint32 px_unset   = SDL_MapRGBA(srf->format, 0, 0, 0, 0);
+
+    for (size_t px_x = 0; px_x < PIXEL_DATA_W; ++px_x)
+    {
+        for (size_t px_y = 0; px_y < PIXEL_DATA_H; ++px_y)
+        {
+            put_px(*srf, px_x, px_y, px_data[px_x][px_y] ? px_set : px_unset);
+        }
+    }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(sdl_renderer_, srf);
+
+    SDL_FreeSurface(srf);
+
+    if (texture)
+    {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+
+    return texture;
+}
+
+void destroy_texture(SDL_Texture*& texture)
+{
+    if (texture)
+    {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+void destroy_sheet_textures()
+{
+    destroy_texture(font_texture_);
+    destroy_texture(font_contour_texture_);
+    destroy_texture(tile_texture_);
+    destroy_texture(tile_contour_texture_);
+}
+
+//Returns false if any texture could not be created, in which case the map is
+//drawn in software instead
+bool load_sheet_textures()
+{
+    TRACE_FUNC_BEGIN;
+
+    font_texture_           = mk_texture(font_px_data_);
+    font_contour_texture_   = mk_texture(font_contour_px_data_);
+
+    bool is_ok = font_texture_ && font_contour_texture_;
+
+    if (config::is_tiles_mode())
+    {
+        tile_texture_           = mk_texture(tile_px_data_);
+        tile_contour_texture_   = mk_texture(tile_contour_px_data_);
+
+        is_ok = is_ok && tile_texture_ && tile_contour_texture_;
+    }
+
+    if (!is_ok)
+    {
+        TRACE << "Failed to create sheet textures, falling back on software "
+              << "map drawing" << std::endl;
+
+        destroy_sheet_textures();
+    }
+
+    TRACE_FUNC_END;
+
+    return is_ok;
+}
+
 void put_pixels_on_scr(const bool px_data[PIXEL_DATA_W][PIXEL_DATA_H],
                        const P& sheet_pos,
                        const P& scr_px_pos,
@@ -292,6 +653,8 @@ void put_pixels_on_scr(const bool px_data[PIXEL_DATA_W][PIXEL_DATA_H],
             }
             ++scr_px_x;
         }
+
+        mark_px_area_dirty(scr_px_pos, P(CELL_W, CELL_H));
     }
 }
 
@@ -345,6 +708,14 @@ int lifebar_length(const Actor& actor)
     return -1;
 }
 
+//Pixel position of the green part of the life bar, the red part follows it
+P life_bar_px_pos(const P& pos)
+{
+    const P px_pos = px_pos_for_cell_in_panel(Panel::map, pos + P(0, 1)) - P(0, 2);
+
+    return px_pos + P(1, 0);
+}
+
 void draw_life_bar(const P& pos, const int LENGTH)
 {
     if (LENGTH >= 0)
@@ -353,18 +724,17 @@ void draw_life_bar(const P& pos, const int LENGTH)
         const int W_GREEN   = LENGTH;
         const int W_BAR_TOT = cell_dims.x - 2;
         const int W_RED     = W_BAR_TOT - W_GREEN;
-        const P px_pos    = px_pos_for_cell_in_panel(Panel::map, pos + P(0, 1)) - P(0, 2);
-        const int X0_GREEN  = px_pos.x + 1;
-        const int X0_RED    = X0_GREEN + W_GREEN;
+        const P px_green    = life_bar_px_pos(pos);
+        const P px_red      = px_green + P(W_GREEN, 0);
 
         if (W_GREEN > 0)
         {
-            draw_line_hor(P(X0_GREEN, px_pos.y), W_GREEN, clr_green_lgt);
+            draw_line_hor(px_green, W_GREEN, clr_green_lgt);
         }
 
         if (W_RED > 0)
         {
-            draw_line_hor(P(X0_RED, px_pos.y), W_RED, clr_red_lgt);
+            draw_line_hor(px_red, W_RED, clr_red_lgt);
         }
     }
 }
@@ -420,6 +790,228 @@ void draw_glyph_at_px(const char GLYPH,
     put_pixels_on_scr_for_glyph(GLYPH, px_pos, clr);
 }
 
+bool is_drawn_equal(const Cell_render_data& d1, const Cell_render_data& d2)
+{
+    return
+        d1.tile             == d2.tile              &&
+        d1.glyph            == d2.glyph             &&
+        d1.lifebar_length   == d2.lifebar_length    &&
+        is_clr_equal(d1.clr,    d2.clr)             &&
+        is_clr_equal(d1.clr_bg, d2.clr_bg);
+}
+
+//Draws a map cell, unless it is already on the screen from a previous frame
+void draw_map_cell(const P& pos,
+                   const Cell_render_data& render_data,
+                   const bool IS_TILE_MODE)
+{
+    Cell_render_data& retained = retained_map_cells_[pos.x][pos.y];
+
+    if (
+        is_map_cell_retained_[pos.x][pos.y] &&
+        is_drawn_equal(retained, render_data))
+    {
+        return;
+    }
+
+    if (is_hw_map_drawing_)
+    {
+        //Leave a transparent hole in the screen surface for the renderer
+        const P px_pos = px_pos_for_cell_in_panel(Panel::map, pos);
+        const P cell_dims(config::cell_px_w(), config::cell_px_h());
+
+        SDL_Rect sdl_rect =
+        {
+            px_pos.x, px_pos.y, cell_dims.x, cell_dims.y
+        };
+
+        SDL_FillRect(scr_srf_,
+                     &sdl_rect,
+                     SDL_MapRGBA(scr_srf_->format, 0, 0, 0, 0));
+
+        mark_px_area_dirty(px_pos, cell_dims);
+
+        is_hw_map_cell_[pos.x][pos.y] = true;
+    }
+    else //Software drawing
+    {
+        cover_cell_in_map(pos);
+
+        bool did_draw = false;
+
+        //Draw tile here if tile mode, and a tile has been set
+        if (IS_TILE_MODE && render_data.tile != Tile_id::empty)
+        {
+            draw_tile(render_data.tile,
+                      Panel::map,
+                      pos,
+                      render_data.clr,
+                      render_data.clr_bg);
+
+            did_draw = true;
+        }
+        else /* Text mode, or no tile set */ if (render_data.glyph != ' ')
+        {
+            draw_glyph(render_data.glyph,
+                       Panel::map,
+                       pos,
+                       render_data.clr,
+                       true,
+                       render_data.clr_bg);
+
+            did_draw = true;
+        }
+
+        //Draw lifebar here?
+        if (did_draw && render_data.lifebar_length != -1)
+        {
+            draw_life_bar(pos, render_data.lifebar_length);
+        }
+    }
+
+    //NOTE: The drawing above has flagged the cell as not retained
+    retained                            = render_data;
+    is_map_cell_retained_[pos.x][pos.y] = true;
+
+    ++nr_map_cells_drawn_;
+}
+
+void hw_fill_rect(const P& px_pos, const P& px_dims, const Clr& clr)
+{
+    const SDL_Rect sdl_rect =
+    {
+        px_pos.x, px_pos.y, px_dims.x, px_dims.y
+    };
+
+    SDL_SetRenderDrawColor(sdl_renderer_, clr.r, clr.g, clr.b, 255);
+
+    SDL_RenderFillRect(sdl_renderer_, &sdl_rect);
+}
+
+void hw_copy_from_sheet(SDL_Texture* const texture,
+                        const P& sheet_pos,
+                        const P& px_pos,
+                        const Clr& clr)
+{
+    const P cell_dims(config::cell_px_w(), config::cell_px_h());
+
+    const SDL_Rect src_rect =
+    {
+        sheet_pos.x * cell_dims.x, sheet_pos.y * cell_dims.y, cell_dims.x, cell_dims.y
+    };
+
+    const SDL_Rect dst_rect =
+    {
+        px_pos.x, px_pos.y, cell_dims.x, cell_dims.y
+    };
+
+    SDL_SetTextureColorMod(texture, clr.r, clr.g, clr.b);
+
+    SDL_RenderCopy(sdl_renderer_, texture, &src_rect, &dst_rect);
+}
+
+//Draws the hardware map cells with the renderer, matching the software drawing
+//of draw_tile() and draw_glyph(). The cells are drawn in one pass per layer, so
+//that consecutive copies use the same texture.
+void render_hw_map_cells()
+{
+    const bool  IS_TILE_MODE = config::is_tiles_mode();
+    const P     cell_dims(config::cell_px_w(), config::cell_px_h());
+
+    //Backgrounds
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            if (is_hw_map_cell_[x][y])
+            {
+                const P px_pos = px_pos_for_cell_in_panel(Panel::map, P(x, y));
+
+                hw_fill_rect(px_pos, cell_dims, retained_map_cells_[x][y].clr_bg);
+            }
+        }
+    }
+
+    //Contours, then foregrounds
+    for (int layer = 0; layer < 2; ++layer)
+    {
+        const bool IS_CONTOUR_LAYER = layer == 0;
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                if (!is_hw_map_cell_[x][y])
+                {
+                    continue;
+                }
+
+                const Cell_render_data& d   = retained_map_cells_[x][y];
+                const P px_pos              = px_pos_for_cell_in_panel(Panel::map, P(x, y));
+                const bool IS_BG_BLACK      = is_clr_equal(d.clr_bg, clr_black);
+
+                if (IS_TILE_MODE && d.tile != Tile_id::empty)
+                {
+                    if (!IS_CONTOUR_LAYER)
+                    {
+                        hw_copy_from_sheet(tile_texture_, art::tile_pos(d.tile), px_pos, d.clr);
+                    }
+                    else if (!IS_BG_BLACK)
+                    {
+                        hw_copy_from_sheet(tile_contour_texture_,
+                                           art::tile_pos(d.tile),
+                                           px_pos,
+                                           clr_black);
+                    }
+                }
+                else if (d.glyph != ' ')
+                {
+                    if (!IS_CONTOUR_LAYER)
+                    {
+                        hw_copy_from_sheet(font_texture_, art::glyph_pos(d.glyph), px_pos, d.clr);
+                    }
+                    else if (!IS_BG_BLACK && !is_clr_equal(d.clr, clr_black))
+                    {
+                        hw_copy_from_sheet(font_contour_texture_,
+                                           art::glyph_pos(d.glyph),
+                                           px_pos,
+                                           clr_black);
+                    }
+                }
+            }
+        }
+    }
+
+    //Life bars
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            const Cell_render_data& d = retained_map_cells_[x][y];
+
+            const bool IS_DRAWN = (IS_TILE_MODE && d.tile != Tile_id::empty) ||
+                                  d.glyph != ' ';
+
+            if (is_hw_map_cell_[x][y] && IS_DRAWN && d.lifebar_length >= 0)
+            {
+                const int W_GREEN   = d.lifebar_length;
+                const int W_RED     = cell_dims.x - 2 - W_GREEN;
+                const P px_green    = life_bar_px_pos(P(x, y));
+
+                if (W_GREEN > 0)
+                {
+                    hw_fill_rect(px_green, P(W_GREEN, 2), clr_green_lgt);
+                }
+
+                if (W_RED > 0)
+                {
+                    hw_fill_rect(px_green + P(W_GREEN, 0), P(W_RED, 2), clr_red_lgt);
+                }
+            }
+        }
+    }
+}
+
 } //namespace
 
 void init()
@@ -492,20 +1084,24 @@ void init()
         ASSERT(false);
     }
 
-    load_font();
+    load_px_data(config::font_name(), font_px_data_, font_contour_px_data_);
 
     if (config::is_tiles_mode())
     {
-        load_tiles();
+        load_px_data(tiles_img_name, tile_px_data_, tile_contour_px_data_);
         load_pictures();
     }
 
-    if (config::is_tiles_mode())
-    {
-        load_contour(tile_px_data_, tile_contour_px_data_);
-    }
+    is_hw_map_drawing_ = config::is_hw_map_drawing() && load_sheet_textures();
+
+    SDL_SetTextureBlendMode(scr_texture_,
+                            is_hw_map_drawing_ ?
+                            SDL_BLENDMODE_BLEND :
+                            SDL_BLENDMODE_NONE);
 
-    load_contour(font_px_data_, font_contour_px_data_);
+    presented_px_.assign(SCR_PX_W * SCR_PX_H, 0);
+
+    reset_retained_state();
 
     TRACE_FUNC_END;
 }
@@ -514,6 +1110,10 @@ void cleanup()
 {
     TRACE_FUNC_BEGIN;
 
+    destroy_sheet_textures();
+
+    is_hw_map_drawing_ = false;
+
     if (sdl_renderer_)
     {
         SDL_DestroyRenderer(sdl_renderer_);
@@ -550,6 +1150,8 @@ void cleanup()
         skull_srf_ = nullptr;
     }
 
+    presented_px_.clear();
+
     TRACE_FUNC_END;
 }
 
@@ -564,25 +1166,143 @@ void on_toggle_fullscreen()
         SDL_SetWindowFullscreen(sdl_window_, SDL_WINDOW_SHOWN);
     }
 
+    is_full_upload_needed_ = true;
+
     update_screen();
 }
 
 void update_screen()
 {
-    if (is_inited())
+    if (!is_inited())
+    {
+        return;
+    }
+
+    const int SCR_PX_W  = config::scr_px_w();
+    const int SCR_PX_H  = config::scr_px_h();
+
+    if (is_full_upload_needed_)
     {
         SDL_UpdateTexture(scr_texture_,
                           nullptr,
                           scr_srf_->pixels,
                           scr_srf_->pitch);
 
+        for (int px_y = 0; px_y < SCR_PX_H; ++px_y)
+        {
+            memcpy(&presented_px_[px_y * SCR_PX_W],
+                   (const Uint8*)scr_srf_->pixels + px_y * scr_srf_->pitch,
+                   SCR_PX_W * sizeof(Uint32));
+        }
+
+        for (int x = 0; x < SCREEN_W; ++x)
+        {
+            for (int y = 0; y < SCREEN_H; ++y)
+            {
+                is_scr_cell_dirty_[x][y] = false;
+            }
+        }
+
+        nr_px_uploaded_         += SCR_PX_W * SCR_PX_H;
+        is_full_upload_needed_   = false;
+    }
+    else //Only upload the parts of the screen that actually changed
+    {
+        const int CELL_PX_W = config::cell_px_w();
+        const int CELL_PX_H = config::cell_px_h();
+
+        for (int y = 0; y < SCREEN_H; ++y)
+        {
+            //Changed cells on each row are uploaded as one span
+            int span_x0 = -1;
+            int span_x1 = -1;
+
+            for (int x = 0; x < SCREEN_W; ++x)
+            {
+                if (is_scr_cell_dirty_[x][y])
+                {
+                    is_scr_cell_dirty_[x][y] = false;
+
+                    if (cpy_presented_cell_px(P(x, y)))
+                    {
+                        if (span_x0 < 0)
+                        {
+                            span_x0 = x;
+                        }
+
+                        span_x1 = x;
+                    }
+                }
+            }
+
+            if (span_x0 >= 0)
+            {
+                const SDL_Rect sdl_rect =
+                {
+                    span_x0 * CELL_PX_W,
+                    y * CELL_PX_H,
+                    (span_x1 - span_x0 + 1) * CELL_PX_W,
+                    CELL_PX_H
+                };
+
+                const Uint8* const px_data = (const Uint8*)scr_srf_->pixels +
+                                             sdl_rect.y * scr_srf_->pitch +
+                                             sdl_rect.x * sizeof(Uint32);
+
+                SDL_UpdateTexture(scr_texture_,
+                                  &sdl_rect,
+                                  px_data,
+                                  scr_srf_->pitch);
+
+                nr_px_uploaded_ += sdl_rect.w * sdl_rect.h;
+            }
+        }
+    }
+
+    if (is_hw_map_drawing_)
+    {
+        //Map cells are drawn in screen surface pixel coordinates, scaled to
+        //the output in the same way as the screen texture
+        int output_w = SCR_PX_W;
+        int output_h = SCR_PX_H;
+
+        SDL_GetRendererOutputSize(sdl_renderer_, &output_w, &output_h);
+
+        SDL_RenderSetScale(sdl_renderer_,
+                           float(output_w) / float(SCR_PX_W),
+                           float(output_h) / float(SCR_PX_H));
+
+        SDL_SetRenderDrawColor(sdl_renderer_, 0, 0, 0, 255);
+
+        SDL_RenderClear(sdl_renderer_);
+
+        render_hw_map_cells();
+
+        const SDL_Rect scr_rect =
+        {
+            0, 0, SCR_PX_W, SCR_PX_H
+        };
+
+        SDL_RenderCopy(sdl_renderer_,
+                       scr_texture_,
+                       nullptr,
+                       &scr_rect);
+    }
+    else //Software drawing
+    {
         SDL_RenderCopy(sdl_renderer_,
                        scr_texture_,
                        nullptr,
                        nullptr);
-
-        SDL_RenderPresent(sdl_renderer_);
     }
+
+    SDL_RenderPresent(sdl_renderer_);
+
+    TRACE_VERBOSE << "Frame cost - map cells drawn: " << nr_map_cells_drawn_
+                  << ", pixels uploaded: " << nr_px_uploaded_ << std::endl;
+
+    nr_map_cells_drawn_ = 0;
+    nr_px_uploaded_     = 0;
 }
 
 void clear_screen()
@@ -592,6 +1312,17 @@ void clear_screen()
         SDL_FillRect(scr_srf_,
                      nullptr,
                      SDL_MapRGB(scr_srf_->format, 0, 0, 0));
+
+        mark_px_area_dirty(P(0, 0), P(config::scr_px_w(), config::scr_px_h()));
+
+        //The whole screen is now opaque, no hardware cells are visible
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                is_hw_map_cell_[x][y] = false;
+            }
+        }
     }
 }
 
@@ -1012,6 +1743,8 @@ int draw_text_center(const std::string& str, const Panel panel, const P& pos,
     SDL_FillRect(scr_srf_, &sdl_rect,
                  SDL_MapRGB(scr_srf_->format, bg_clr.r, bg_clr.g, bg_clr.b));
 
+    mark_px_area_dirty(px_pos, P(W_TOT_PIXEL, cell_dims.y));
+
     for (int i = 0; i < LEN; ++i)
     {
         if (px_pos.x < 0 || px_pos.x >= config::scr_px_w())
@@ -1107,6 +1840,8 @@ void draw_rectangle_solid(const P& px_pos, const P& px_dims, const Clr& clr)
         SDL_FillRect(scr_srf_,
                      &sdl_rect,
                      SDL_MapRGB(scr_srf_->format, clr.r, clr.g, clr.b));
+
+        mark_px_area_dirty(px_pos, px_dims);
     }
 }
 
@@ -1229,8 +1964,8 @@ void draw_descr_box(const std::vector<Str_and_clr>& lines)
 
     for (const auto& line : lines)
     {
-        std::vector<std::string> formatted;
-        text_format::split(line.str, MAX_W, formatted);
+        const std::vector<std::string>& formatted =
+            text_format::split_cached(line.str, MAX_W);
 
         for (const auto& line_in_formatted : formatted)
         {
@@ -1295,17 +2030,21 @@ void draw_info_scr_interface(const std::string& title,
 void draw_map_state(const Update_screen update,
                     Cell_overlay overlay[MAP_W][MAP_H])
 {
-    if (!is_inited())
+    PROFILE_ZONE("render::draw_map_state");
+
+    if (!is_inited() || is_fast_forwarding_)
     {
         return;
     }
 
-    clear_screen();
-
+    //NOTE: The screen is not cleared here - the map keeps whatever cells are
+    //unchanged since the last frame, and the panels cover their own areas
     draw_map(overlay);
 
     character_lines::draw();
 
+    cover_panel(Panel::log);
+
     msg_log::draw(Update_screen::no);
 
     if (update == Update_screen::yes)
@@ -1314,6 +2053,16 @@ void draw_map_state(const Update_screen update,
     }
 }
 
+void set_fast_forward(const bool IS_FAST_FORWARD)
+{
+    is_fast_forwarding_ = IS_FAST_FORWARD;
+}
+
+bool is_fast_forwarding()
+{
+    return is_fast_forwarding_;
+}
+
 void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
 {
     if (!is_inited())
@@ -1325,6 +2074,8 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
 
     const bool IS_TILE_MODE = config::is_tiles_mode();
 
+    const Cell_planes& planes = map::planes;
+
     //---------------- INSERT RIGIDS AND BLOOD INTO ARRAY
     for (int x = 0; x < MAP_W; ++x)
     {
@@ -1333,10 +2084,10 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
             //Reset render data at this position
             render_array[x][y] = Cell_render_data();
 
-            if (map::cells[x][y].is_seen_by_player)
+            if (planes.is_seen_by_player[x][y])
             {
                 render_data                     = &render_array[x][y];
-                const auto* const   f           = map::cells[x][y].rigid;
+                const auto* const   f           = planes.rigid[x][y];
                 Tile_id             gore_tile   = Tile_id::empty;
                 char                gore_glyph  = 0;
 
@@ -1366,7 +2117,7 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
                     render_data->clr   = clr_red;
                 }
 
-                if (map::cells[x][y].is_lit && f->is_los_passable())
+                if (planes.is_lit[x][y] && f->is_los_passable())
                 {
                     render_data->is_marked_lit = true;
                 }
@@ -1398,10 +2149,10 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
         {
             render_data = &render_array[x][y];
 
-            if (map::cells[x][y].is_seen_by_player)
+            if (planes.is_seen_by_player[x][y])
             {
                 //---------------- INSERT ITEMS INTO ARRAY
-                const Item* const item = map::cells[x][y].item;
+                const Item* const item = planes.item[x][y];
 
                 if (item)
                 {
@@ -1425,6 +2176,26 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
         }
     }
 
+    //---------------- INSERT GASES INTO ARRAY
+    if (gas::is_any_gas())
+    {
+        const Feature_data_t& smoke_data = feature_data::data(Feature_id::smoke);
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                if (planes.is_seen_by_player[x][y] && gas::has_gas(Gas_id::smoke, P(x, y)))
+                {
+                    render_data = &render_array[x][y];
+                    render_data->clr   = clr_gray;
+                    render_data->tile  = smoke_data.tile;
+                    render_data->glyph = smoke_data.glyph;
+                }
+            }
+        }
+    }
+
     //---------------- INSERT MOBILE FEATURES INTO ARRAY
     for (auto* mob : game_time::mobs)
     {
@@ -1504,6 +2275,43 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
         }
     }
 
+    //---------------- SET UP PLAYER CHARACTER
+    //NOTE: The player is drawn as part of the grid, so that the player cell is
+    //also only redrawn when it changes
+    const P& player_pos = map::player->pos;
+
+    Cell_render_data player_render_data;
+
+    {
+        Item*       item        = map::player->inv().item_in_slot(Slot_id::wpn);
+        const bool  IS_GHOUL    = player_bon::bg() == Bg::ghoul;
+        bool        uses_ranged_wpn = false;
+
+        if (item)
+        {
+            uses_ranged_wpn = item->data().ranged.is_ranged_wpn;
+        }
+
+        player_render_data.tile = IS_GHOUL          ? Tile_id::ghoul :
+                                  uses_ranged_wpn   ? Tile_id::player_firearm :
+                                  Tile_id::player_melee;
+
+        player_render_data.glyph            = '@';
+        player_render_data.clr              = map::player->clr();
+        player_render_data.lifebar_length   = lifebar_length(*map::player);
+
+        //Overlay?
+        if (overlay)
+        {
+            const Cell_overlay& overlay_here = overlay[player_pos.x][player_pos.y];
+
+            if (!is_clr_equal(overlay_here.clr_bg, clr_black))
+            {
+                player_render_data.clr_bg = overlay_here.clr_bg;
+            }
+        }
+    }
+
     //---------------- DRAW THE GRID
     for (int x = 0; x < MAP_W; ++x)
     {
@@ -1575,7 +2383,7 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
                     if (IS_TILE_WALL)
                     {
                         const auto* const   f               = cell.rigid;
-                        const auto          feature_id      = f->id();
+                        const auto          feature_id      = cell.rigid_id;
                         bool                is_hidden_door  = false;
 
                         if (feature_id == Feature_id::door)
@@ -1691,36 +2499,12 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
                 }
             }
 
-            bool did_draw = false;
-
-            //Draw tile here if tile mode, and a tile has been set
-            if (IS_TILE_MODE && render_data_cpy.tile != Tile_id::empty)
+            if (pos == player_pos)
             {
-                draw_tile(render_data_cpy.tile,
-                          Panel::map,
-                          pos,
-                          render_data_cpy.clr,
-                          render_data_cpy.clr_bg);
-
-                did_draw = true;
-            }
-            else /* Text mode, or no tile set */ if (render_data_cpy.glyph != ' ')
-            {
-                draw_glyph(render_data_cpy.glyph,
-                           Panel::map,
-                           pos,
-                           render_data_cpy.clr,
-                           true,
-                           render_data_cpy.clr_bg);
-
-                did_draw = true;
+                render_data_cpy = player_render_data;
             }
 
-            //Draw lifebar here?
-            if (did_draw && render_data_cpy.lifebar_length != -1)
-            {
-                draw_life_bar(pos, render_data_cpy.lifebar_length);
-            }
+            draw_map_cell(pos, render_data_cpy, IS_TILE_MODE);
 
             if (!cell.is_explored)
             {
@@ -1729,59 +2513,8 @@ void draw_map(Cell_overlay overlay[MAP_W][MAP_H])
         }
     }
 
-    //---------------- DRAW PLAYER CHARACTER
-    const P&    pos         = map::player->pos;
-    Item*       item        = map::player->inv().item_in_slot(Slot_id::wpn);
-    const bool  IS_GHOUL    = player_bon::bg() == Bg::ghoul;
-
-    Clr clr_bg = clr_black;
-
-    //Overlay?
-    if (overlay)
-    {
-        const Cell_overlay& overlay_here = overlay[pos.x][pos.y];
-
-        if (!is_clr_equal(overlay_here.clr_bg, clr_black))
-        {
-            clr_bg = overlay_here.clr_bg;
-        }
-    }
-
-    if (IS_TILE_MODE)
-    {
-        bool uses_ranged_wpn = false;
-
-        if (item)
-        {
-            uses_ranged_wpn = item->data().ranged.is_ranged_wpn;
-        }
-
-        const Tile_id tile = IS_GHOUL           ? Tile_id::ghoul :
-                             uses_ranged_wpn    ? Tile_id::player_firearm :
-                             Tile_id::player_melee;
-
-        draw_tile(tile,
-                  Panel::map,
-                  pos, map::player->clr(),
-                  clr_bg);
-    }
-    else //Text mode
-    {
-        draw_glyph('@',
-                   Panel::map,
-                   pos,
-                   map::player->clr(),
-                   true,
-                   clr_bg);
-    }
-
-    const int LIFE_BAR_LENGTH = lifebar_length(*map::player);
-
-    if (LIFE_BAR_LENGTH != -1)
-    {
-        draw_life_bar(pos, LIFE_BAR_LENGTH);
-    }
-
+    //NOTE: The exclamation marks are drawn on top of the retained cells, and
+    //will cause them to be redrawn next frame
     draw_player_shock_excl_marks();
 }
 
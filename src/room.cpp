@@ -1204,7 +1204,7 @@ void Chasm_room::on_post_connect_hook(bool door_proposals[MAP_W][MAP_H])
         {
             const P p(x, y);
 
-            if (p == origin || flood[x][y] != 0)
+            if (flood[x][y] != flood_fill::unreached)
             {
                 map::put(new Chasm(p));
             }
@@ -1340,7 +1340,7 @@ void River_room::on_pre_connect(bool door_proposals[MAP_W][MAP_H])
         {
             const P p(x, y);
 
-            if (flood[x][y] > 0 || p == origin)
+            if (flood[x][y] != flood_fill::unreached)
             {
                 map::put(new Chasm(p));
                 map::room_map[x][y] = this;
@@ -1623,7 +1623,7 @@ void River_room::on_pre_connect(bool door_proposals[MAP_W][MAP_H])
 
     if (c_built.empty())
     {
-        mapgen::is_map_valid = false;
+        mapgen::mk_map_invalid(Map_invalid_reason::bridges);
     }
     else //map is valid (at least one bridge was built)
     {
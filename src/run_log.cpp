@@ -0,0 +1,396 @@
+#include "run_log.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+#include "init.hpp"
+#include "rl_utils.hpp"
+
+Run_record::Run_record() :
+    score       (0),
+    xp          (0),
+    lvl         (0),
+    dlvl        (0),
+    ins         (0),
+    is_win      (0),
+    bg          (0),
+    is_bot      (0),
+    nr_turns    (0),
+    nr_kills    (0)
+{
+    memset(date_and_time,   0, sizeof(date_and_time));
+    memset(name,            0, sizeof(name));
+    memset(death_cause,     0, sizeof(death_cause));
+    memset(killer_name,     0, sizeof(killer_name));
+}
+
+namespace run_log
+{
+
+namespace
+{
+
+const char log_magic[4] = {'I', 'A', 'R', 'L'};
+const char top_magic[4] = {'I', 'A', 'R', 'T'};
+
+const int32_t version   = 1;
+
+//Written first in both the log and the index file
+struct File_header
+{
+    char    magic[4];
+    int32_t version;
+    int32_t entry_size;
+};
+
+//Entry in the index of the best scoring runs
+struct Top_entry
+{
+    int32_t record_idx;
+    int32_t score;
+};
+
+std::string top_file_path(const std::string& file_path)
+{
+    return file_path + "_top";
+}
+
+void mk_header(const char magic[4], const int32_t ENTRY_SIZE, File_header& out)
+{
+    memset(&out, 0, sizeof(out));
+
+    memcpy(out.magic, magic, sizeof(out.magic));
+
+    out.version     = version;
+    out.entry_size  = ENTRY_SIZE;
+}
+
+//Reads the header at the start of the file, returns false if the file is not
+//of the expected type and version
+bool is_header_ok(std::istream& file, const char magic[4], const int32_t ENTRY_SIZE)
+{
+    File_header expected;
+    mk_header(magic, ENTRY_SIZE, expected);
+
+    File_header header;
+
+    file.seekg(0, std::ios::beg);
+
+    file.read((char*)&header, sizeof(header));
+
+    return
+        size_t(file.gcount()) == sizeof(header) &&
+        memcmp(&header, &expected, sizeof(header)) == 0;
+}
+
+std::streamoff record_offset(const size_t IDX)
+{
+    return std::streamoff(sizeof(File_header) + (IDX * sizeof(Run_record)));
+}
+
+//NOTE: A partially written record at the end of the file (e.g. if the game
+//crashed while writing) is not counted, and will be overwritten by the next
+//record appended
+size_t nr_records_for_file_size(const std::streamoff FILE_SIZE)
+{
+    if (FILE_SIZE < std::streamoff(sizeof(File_header)))
+    {
+        return 0;
+    }
+
+    return size_t(FILE_SIZE - std::streamoff(sizeof(File_header))) / sizeof(Run_record);
+}
+
+std::streamoff file_size(std::istream& file)
+{
+    file.seekg(0, std::ios::end);
+
+    return file.tellg();
+}
+
+bool read_record_at(std::istream& file, const size_t IDX, Run_record& out)
+{
+    //Reset the state after any previous failed read
+    file.clear();
+
+    file.seekg(record_offset(IDX), std::ios::beg);
+
+    file.read((char*)&out, sizeof(Run_record));
+
+    return size_t(file.gcount()) == sizeof(Run_record);
+}
+
+//Inserts the entry after any entries with the same score (so older runs stay
+//ahead on ties), and drops the lowest entry if the index is full
+void insert_top_entry(std::vector<Top_entry>& entries, const Top_entry& entry)
+{
+    auto cmp = [](const Top_entry & e0, const Top_entry & e1)
+    {
+        return e0.score > e1.score;
+    };
+
+    const auto it = std::upper_bound(entries.begin(), entries.end(), entry, cmp);
+
+    entries.insert(it, entry);
+
+    if (entries.size() > max_nr_top_records)
+    {
+        entries.pop_back();
+    }
+}
+
+//Returns false if there is no index, or if it does not match the log
+bool read_top_index(const std::string& file_path,
+                    const size_t NR_LOG_RECORDS,
+                    std::vector<Top_entry>& out)
+{
+    std::ifstream file(top_file_path(file_path), std::ios::binary);
+
+    if (!file.is_open() || !is_header_ok(file, top_magic, sizeof(Top_entry)))
+    {
+        return false;
+    }
+
+    //Number of records in the log when the index was written
+    int32_t nr_log_records  = 0;
+    int32_t nr_entries      = 0;
+
+    file.read((char*)&nr_log_records, sizeof(nr_log_records));
+    file.read((char*)&nr_entries, sizeof(nr_entries));
+
+    if (
+        !file                                       ||
+        size_t(nr_log_records) != NR_LOG_RECORDS    ||
+        nr_entries < 0                              ||
+        size_t(nr_entries) > max_nr_top_records)
+    {
+        return false;
+    }
+
+    out.resize(nr_entries);
+
+    file.read((char*)out.data(), nr_entries * sizeof(Top_entry));
+
+    if (size_t(file.gcount()) != (nr_entries * sizeof(Top_entry)))
+    {
+        out.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void write_top_index(const std::string& file_path,
+                     const size_t NR_LOG_RECORDS,
+                     const std::vector<Top_entry>& entries)
+{
+    std::ofstream file(top_file_path(file_path), std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        TRACE << "Failed to write run log index for " << file_path << std::endl;
+        return;
+    }
+
+    File_header header;
+    mk_header(top_magic, sizeof(Top_entry), header);
+
+    const int32_t NR_LOG_RECORDS_I32    = int32_t(NR_LOG_RECORDS);
+    const int32_t NR_ENTRIES            = int32_t(entries.size());
+
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)&NR_LOG_RECORDS_I32, sizeof(NR_LOG_RECORDS_I32));
+    file.write((const char*)&NR_ENTRIES, sizeof(NR_ENTRIES));
+    file.write((const char*)entries.data(), entries.size() * sizeof(Top_entry));
+}
+
+//Gets the index for the first records of the log, the index is rebuilt (and
+//written) by reading the log if needed
+void top_entries(const std::string& file_path,
+                 const size_t NR_LOG_RECORDS,
+                 std::vector<Top_entry>& out)
+{
+    if (read_top_index(file_path, NR_LOG_RECORDS, out))
+    {
+        return;
+    }
+
+    TRACE << "Rebuilding run log index for " << file_path << std::endl;
+
+    out.clear();
+
+    std::ifstream file(file_path, std::ios::binary);
+
+    if (file.is_open() && is_header_ok(file, log_magic, sizeof(Run_record)))
+    {
+        Run_record record;
+
+        for (size_t i = 0; i < NR_LOG_RECORDS && read_record_at(file, i, record); ++i)
+        {
+            if (!record.is_bot)
+            {
+                insert_top_entry(out, {int32_t(i), record.score});
+            }
+        }
+    }
+
+    write_top_index(file_path, NR_LOG_RECORDS, out);
+}
+
+} //namespace
+
+void set_str(char* const dst, const std::string& src)
+{
+    const size_t LEN = std::min(src.size(), run_record_str_len - 1);
+
+    memcpy(dst, src.data(), LEN);
+
+    memset(dst + LEN, 0, run_record_str_len - LEN);
+}
+
+void append(const Run_record& record, const std::string& file_path)
+{
+    TRACE_FUNC_BEGIN;
+
+    std::streamoff size = 0;
+
+    {
+        std::ifstream file(file_path, std::ios::binary);
+
+        if (file.is_open())
+        {
+            size = file_size(file);
+
+            if (
+                size >= std::streamoff(sizeof(File_header)) &&
+                !is_header_ok(file, log_magic, sizeof(Run_record)))
+            {
+                //Do not overwrite a log from another version of the game
+                TRACE << "Unknown run log format in " << file_path
+                      << ", the run is not recorded" << std::endl;
+                TRACE_FUNC_END;
+                return;
+            }
+        }
+    }
+
+    const size_t IDX = nr_records_for_file_size(size);
+
+    if (IDX == 0)
+    {
+        //New log - write the header
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+
+        File_header header;
+        mk_header(log_magic, sizeof(Run_record), header);
+
+        file.write((const char*)&header, sizeof(header));
+    }
+
+    //Write the record at its offset (instead of appending to the end of the
+    //file), in case the last record was only partially written
+    std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+
+    if (!file.is_open())
+    {
+        TRACE << "Failed to open run log " << file_path << std::endl;
+        TRACE_FUNC_END;
+        return;
+    }
+
+    file.seekp(record_offset(IDX), std::ios::beg);
+
+    file.write((const char*)&record, sizeof(Run_record));
+
+    file.close();
+
+    //Update the index with the new record (this only reads and writes the
+    //small index file, unless it needs to be rebuilt)
+    std::vector<Top_entry> top;
+
+    top_entries(file_path, IDX, top);
+
+    if (!record.is_bot)
+    {
+        insert_top_entry(top, {int32_t(IDX), record.score});
+    }
+
+    write_top_index(file_path, IDX + 1, top);
+
+    TRACE_FUNC_END;
+}
+
+size_t nr_records(const std::string& file_path)
+{
+    std::ifstream file(file_path, std::ios::binary);
+
+    if (!file.is_open() || !is_header_ok(file, log_magic, sizeof(Run_record)))
+    {
+        return 0;
+    }
+
+    return nr_records_for_file_size(file_size(file));
+}
+
+bool read_record(const size_t IDX, Run_record& out, const std::string& file_path)
+{
+    std::ifstream file(file_path, std::ios::binary);
+
+    if (!file.is_open() || !is_header_ok(file, log_magic, sizeof(Run_record)))
+    {
+        return false;
+    }
+
+    return read_record_at(file, IDX, out);
+}
+
+void read_all(std::vector<Run_record>& out, const std::string& file_path)
+{
+    out.clear();
+
+    std::ifstream file(file_path, std::ios::binary);
+
+    if (!file.is_open() || !is_header_ok(file, log_magic, sizeof(Run_record)))
+    {
+        return;
+    }
+
+    out.resize(nr_records_for_file_size(file_size(file)));
+
+    //Read all records at once
+    file.seekg(record_offset(0), std::ios::beg);
+
+    file.read((char*)out.data(), out.size() * sizeof(Run_record));
+}
+
+void read_top(std::vector<Run_record>& out, const std::string& file_path)
+{
+    out.clear();
+
+    const size_t NR_LOG_RECORDS = nr_records(file_path);
+
+    if (NR_LOG_RECORDS == 0)
+    {
+        return;
+    }
+
+    std::vector<Top_entry> top;
+
+    top_entries(file_path, NR_LOG_RECORDS, top);
+
+    std::ifstream file(file_path, std::ios::binary);
+
+    Run_record record;
+
+    for (const Top_entry& entry : top)
+    {
+        if (read_record_at(file, size_t(entry.record_idx), record))
+        {
+            out.push_back(record);
+        }
+    }
+}
+
+} //run_log
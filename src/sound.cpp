@@ -9,6 +9,7 @@
 #include "actor_mon.hpp"
 #include "game_time.hpp"
 #include "map_parsing.hpp"
+#include "profiler.hpp"
 
 Snd::Snd(
     const std::string&              msg,
@@ -51,6 +52,8 @@ void reset_nr_snd_msg_printed_cur_turn()
 
 void run(Snd snd)
 {
+    PROFILE_ZONE("snd_emit::run");
+
     bool blocked[MAP_W][MAP_H];
 
     for (int x = 0; x < MAP_W; ++x)
@@ -68,8 +71,6 @@ void run(Snd snd)
 
     flood_fill::run(origin, blocked, flood_fill, 999, P(-1, -1), true);
 
-    flood_fill[origin.x][origin.y] = 0;
-
     for (Actor* actor : game_time::actors)
     {
         const int FLOOD_VAL_AT_ACTOR = flood_fill[actor->pos.x][actor->pos.y];
@@ -808,7 +808,7 @@ Spell_effect_noticed Spell_anim_wpns::cast_impl(Actor* const caster) const
         {
             for (int y = 0; y < MAP_H; ++y)
             {
-                Cell& cell = map::cells[x][y];
+                Cell cell = map::cells[x][y];
 
                 Item* const item = cell.item;
 
@@ -3,35 +3,41 @@
 #include "init.hpp"
 
 #include <algorithm>
+#include <functional>
 
 namespace
 {
 
-//Reads and removes the first word of the string.
-void read_and_remove_word(std::string& line, std::string& word_ref)
+struct Split_cache_entry
 {
-    word_ref = "";
+    size_t                      hash    = 0;
+    int                         max_w   = -1;
+    std::string                 line;
+    std::vector<std::string>    lines;
+};
+
+const size_t split_cache_size = 32;
+
+Split_cache_entry   split_cache_[split_cache_size];
+size_t              split_cache_next_idx_ = 0;
+
+//Finds the word starting at the given position (ending at a space or at the end
+//of the line), and returns the position after the word and its trailing space
+size_t read_word(const std::string& line,
+                 const size_t BEGIN,
+                 text_format::Text_span& word_ref)
+{
+    size_t end = line.find(' ', BEGIN);
 
-    for (auto it = begin(line); it != end(line); /* No increment */)
+    if (end == std::string::npos)
     {
-        const char CUR_CHAR = *it;
-
-        line.erase(it);
-
-        if (CUR_CHAR == ' ')
-        {
-            break;
-        }
-
-        word_ref += CUR_CHAR;
+        end = line.size();
     }
-}
 
-bool is_word_fit(const std::string& cur_string,
-                 const std::string& word_to_fit,
-                 const size_t MAX_W)
-{
-    return (cur_string.size() + word_to_fit.size() + 1) <= MAX_W;
+    word_ref.begin  = BEGIN;
+    word_ref.len    = end - BEGIN;
+
+    return std::min(end + 1, line.size());
 }
 
 } //namespace
@@ -40,9 +46,9 @@ bool is_word_fit(const std::string& cur_string,
 namespace text_format
 {
 
-void split(std::string line,
-           const int MAX_W,
-           std::vector<std::string>& out)
+void split_spans(const std::string& line,
+                 const int MAX_W,
+                 std::vector<Text_span>& out)
 {
     out.clear();
 
@@ -51,41 +57,85 @@ void split(std::string line,
         return;
     }
 
-    std::string cur_word = "";
+    Text_span cur_word;
 
-    read_and_remove_word(line, cur_word);
+    size_t pos = read_word(line, 0, cur_word);
 
-    if (line.empty())
+    if (pos == line.size())
     {
-        out = {cur_word};
+        out.push_back(cur_word);
         return;
     }
 
-    out.resize(1);
-    out[0] = "";
-
-    size_t cur_row_idx = 0;
+    out.push_back({0, 0});
 
-    while (!cur_word.empty())
+    //NOTE: Reading stops at the first empty word (i.e. at two spaces in a row),
+    //so the words on each line are separated by exactly one space in the input,
+    //and each line is a single range of the input
+    while (cur_word.len > 0)
     {
-        if (!is_word_fit(out[cur_row_idx], cur_word, MAX_W))
+        //The space before the word is counted even on an empty line
+        if (out.back().len + cur_word.len + 1 > size_t(MAX_W))
         {
             //Current word did not fit on current line, make a new line
-            ++cur_row_idx;
-            out.resize(cur_row_idx + 1);
-            out[cur_row_idx] = "";
+            out.push_back({0, 0});
         }
 
-        //If this is not the first word on the current line, add a space before the word
-        if (!out[cur_row_idx].empty())
+        Text_span& cur_line = out.back();
+
+        if (cur_line.len == 0)
+        {
+            cur_line = cur_word;
+        }
+        else
         {
-            out[cur_row_idx] += " ";
+            cur_line.len = cur_word.begin + cur_word.len - cur_line.begin;
         }
 
-        out[cur_row_idx] += cur_word;
+        pos = read_word(line, pos, cur_word);
+    }
+}
+
+void split(const std::string& line,
+           const int MAX_W,
+           std::vector<std::string>& out)
+{
+    std::vector<Text_span> spans;
+
+    split_spans(line, MAX_W, spans);
+
+    out.clear();
+    out.reserve(spans.size());
+
+    for (const Text_span& span : spans)
+    {
+        out.push_back(line.substr(span.begin, span.len));
+    }
+}
 
-        read_and_remove_word(line, cur_word);
+const std::vector<std::string>& split_cached(const std::string& line, const int MAX_W)
+{
+    const size_t HASH = std::hash<std::string>()(line);
+
+    for (const Split_cache_entry& entry : split_cache_)
+    {
+        if (entry.hash == HASH && entry.max_w == MAX_W && entry.line == line)
+        {
+            return entry.lines;
+        }
     }
+
+    Split_cache_entry& entry = split_cache_[split_cache_next_idx_];
+
+    split_cache_next_idx_ = (split_cache_next_idx_ + 1) % split_cache_size;
+
+    entry.hash  = HASH;
+    entry.max_w = MAX_W;
+    entry.line  = line;
+
+    split(line, MAX_W, entry.lines);
+
+    return entry.lines;
 }
 
 void space_separated_list(const std::string& line,
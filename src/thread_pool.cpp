@@ -0,0 +1,183 @@
+#include "thread_pool.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include <SDL.h>
+
+#include "init.hpp"
+#include "rl_utils.hpp"
+
+namespace thread_pool
+{
+
+namespace
+{
+
+const int max_nr_workers_ = 15;
+
+std::vector<SDL_Thread*> workers_;
+
+SDL_sem*    start_sem_  = nullptr;
+SDL_sem*    done_sem_   = nullptr;
+
+SDL_atomic_t is_quitting_;
+SDL_atomic_t next_job_;
+
+size_t nr_jobs_ = 0;
+
+const std::function<void(const size_t)>* job_ = nullptr;
+
+void run_jobs()
+{
+    while (true)
+    {
+        const size_t JOB_IDX = size_t(SDL_AtomicAdd(&next_job_, 1));
+
+        if (JOB_IDX >= nr_jobs_)
+        {
+            break;
+        }
+
+        (*job_)(JOB_IDX);
+    }
+}
+
+int worker(void* data)
+{
+    (void)data;
+
+    while (true)
+    {
+        SDL_SemWait(start_sem_);
+
+        if (SDL_AtomicGet(&is_quitting_))
+        {
+            break;
+        }
+
+        run_jobs();
+
+        SDL_SemPost(done_sem_);
+    }
+
+    return 0;
+}
+
+} //namespace
+
+void init()
+{
+    TRACE_FUNC_BEGIN;
+
+    cleanup();
+
+    const int NR_WORKERS = std::min(SDL_GetCPUCount() - 1, max_nr_workers_);
+
+    if (NR_WORKERS <= 0)
+    {
+        TRACE << "Single core, not starting any worker threads" << std::endl;
+        TRACE_FUNC_END;
+        return;
+    }
+
+    SDL_AtomicSet(&is_quitting_, 0);
+
+    start_sem_  = SDL_CreateSemaphore(0);
+    done_sem_   = SDL_CreateSemaphore(0);
+
+    if (!start_sem_ || !done_sem_)
+    {
+        TRACE << "Failed to create semaphores: " << SDL_GetError() << std::endl;
+        cleanup();
+        TRACE_FUNC_END;
+        return;
+    }
+
+    for (int i = 0; i < NR_WORKERS; ++i)
+    {
+        SDL_Thread* const thread = SDL_CreateThread(worker, "worker", nullptr);
+
+        if (!thread)
+        {
+            TRACE << "Failed to create worker thread: " << SDL_GetError() << std::endl;
+            break;
+        }
+
+        workers_.push_back(thread);
+    }
+
+    TRACE << "Started " << workers_.size() << " worker threads" << std::endl;
+
+    TRACE_FUNC_END;
+}
+
+void cleanup()
+{
+    SDL_AtomicSet(&is_quitting_, 1);
+
+    for (size_t i = 0; i < workers_.size(); ++i)
+    {
+        SDL_SemPost(start_sem_);
+    }
+
+    for (SDL_Thread* const thread : workers_)
+    {
+        SDL_WaitThread(thread, nullptr);
+    }
+
+    workers_.clear();
+
+    if (start_sem_)
+    {
+        SDL_DestroySemaphore(start_sem_);
+        start_sem_ = nullptr;
+    }
+
+    if (done_sem_)
+    {
+        SDL_DestroySemaphore(done_sem_);
+        done_sem_ = nullptr;
+    }
+}
+
+int nr_threads()
+{
+    return int(workers_.size()) + 1;
+}
+
+void run(const size_t NR_JOBS, const std::function<void(const size_t)>& job)
+{
+    //Not worth waking up the workers for a single job
+    if (workers_.empty() || NR_JOBS <= 1)
+    {
+        for (size_t i = 0; i < NR_JOBS; ++i)
+        {
+            job(i);
+        }
+
+        return;
+    }
+
+    job_        = &job;
+    nr_jobs_    = NR_JOBS;
+
+    SDL_AtomicSet(&next_job_, 0);
+
+    for (size_t i = 0; i < workers_.size(); ++i)
+    {
+        SDL_SemPost(start_sem_);
+    }
+
+    run_jobs();
+
+    for (size_t i = 0; i < workers_.size(); ++i)
+    {
+        SDL_SemWait(done_sem_);
+    }
+
+    job_        = nullptr;
+    nr_jobs_    = 0;
+}
+
+} //thread_pool
@@ -3,6 +3,7 @@
 #include "UnitTest++.h"
 
 #include <climits>
+#include <cstdio>
 #include <string>
 
 #include <SDL.h>
@@ -18,6 +19,8 @@
 #include "actor_Mon.hpp"
 #include "mapgen.hpp"
 #include "map_parsing.hpp"
+#include "bit_grid.hpp"
+#include "thread_pool.hpp"
 #include "fov.hpp"
 #include "line_calc.hpp"
 #include "save_handling.hpp"
@@ -30,6 +33,10 @@
 #include "feature_trap.hpp"
 #include "drop.hpp"
 #include "map_travel.hpp"
+#include "map_templates.hpp"
+#include "gas.hpp"
+#include "msg_log.hpp"
+#include "run_log.hpp"
 
 struct Basic_fixture
 {
@@ -233,6 +240,38 @@ TEST(format_text)
     CHECK(formatted_lines.empty());
 }
 
+TEST(format_text_spans_and_cache)
+{
+    const std::string str = "one two three four";
+
+    std::vector<text_format::Text_span> spans;
+
+    text_format::split_spans(str, 11, spans);
+    CHECK_EQUAL(2, int(spans.size()));
+    CHECK_EQUAL(0, int(spans[0].begin));
+    CHECK_EQUAL(7, int(spans[0].len));
+    CHECK_EQUAL(8, int(spans[1].begin));
+    CHECK_EQUAL(10, int(spans[1].len));
+
+    //Cached lines should be the same as when splitting directly
+    std::vector<std::string> formatted_lines;
+
+    text_format::split(str, 11, formatted_lines);
+
+    const std::vector<std::string>* cached = &text_format::split_cached(str, 11);
+
+    CHECK(*cached == formatted_lines);
+
+    //Splitting the same text again should give the same (cached) lines
+    CHECK(&text_format::split_cached(str, 11) == cached);
+
+    //Another width should not give the cached lines
+    const std::vector<std::string>& other_w = text_format::split_cached(str, 100);
+
+    CHECK_EQUAL(1, int(other_w.size()));
+    CHECK_EQUAL(str, other_w[0]);
+}
+
 TEST_FIXTURE(Basic_fixture, line_calculation)
 {
     P origin(0, 0);
@@ -400,6 +439,54 @@ TEST_FIXTURE(Basic_fixture, fov)
     CHECK(fov[X - R + 1][Y + R - 1].is_blocked_hard);
 }
 
+TEST_FIXTURE(Basic_fixture, los_cache)
+{
+    bool blocked[MAP_W][MAP_H] = {};
+
+    const P p0(MAP_W_HALF, MAP_H_HALF);
+    const P p1(p0.x + 4, p0.y);
+
+    Los_cache cache;
+
+    CHECK(!cache.check_cell(p0, p1, blocked).is_blocked_hard);
+
+    //The stored result is used until line of sight is marked as changed
+    blocked[p0.x + 2][p0.y] = true;
+
+    CHECK(!cache.check_cell(p0, p1, blocked).is_blocked_hard);
+
+    fov::on_los_changed();
+
+    CHECK(cache.check_cell(p0, p1, blocked).is_blocked_hard);
+
+    //Moving the origin discards the stored results
+    blocked[p0.x + 2][p0.y] = false;
+
+    CHECK(!cache.check_cell(p0 + P(0, 1), p1, blocked).is_blocked_hard);
+
+    //Outside FOV range
+    const P p_far(p0.x + FOV_STD_RADI_INT + 1, p0.y);
+
+    CHECK(cache.check_cell(p0, p_far, blocked).is_blocked_hard);
+}
+
+TEST_FIXTURE(Basic_fixture, thread_pool_runs_all_jobs)
+{
+    const size_t NR_JOBS = 1000;
+
+    std::vector<int> nr_runs(NR_JOBS, 0);
+
+    thread_pool::run(NR_JOBS, [&](const size_t i)
+    {
+        ++nr_runs[i];
+    });
+
+    for (const int NR : nr_runs)
+    {
+        CHECK_EQUAL(1, NR);
+    }
+}
+
 TEST_FIXTURE(Basic_fixture, light_map)
 {
     //Put walls on the edge of the map, and floor in all other cells, and make all cells dark
@@ -409,7 +496,7 @@ TEST_FIXTURE(Basic_fixture, light_map)
         {
             const P p(x, y);
 
-            Cell& cell = map::cells[p.x][p.y];
+            Cell cell = map::cells[p.x][p.y];
 
             cell.is_dark    = true;
             cell.is_lit     = false;
@@ -785,7 +872,7 @@ TEST_FIXTURE(Basic_fixture, inventory_handling)
     CHECK(!body_slot.item);
 
     //Check that the item is on the ground
-    Cell& cell = map::cells[p.x][p.y];
+    Cell cell = map::cells[p.x][p.y];
     CHECK(cell.item);
 
     //Check that the properties are cleared
@@ -1108,6 +1195,343 @@ TEST_FIXTURE(Basic_fixture, loading_game)
     CHECK_EQUAL(0, game_time::turn());
 }
 
+TEST_FIXTURE(Basic_fixture, new_session_resets_data)
+{
+    Item_data_t&    scroll_d    = item_data::data[int(Item_id::scroll_telep)];
+    Actor_data_t&   zuul_d      = actor_data::data[int(Actor_id::zuul)];
+    Actor_data_t&   player_d    = actor_data::data[int(Actor_id::player)];
+
+    const int ZUUL_NR_LEFT = zuul_d.nr_left_allowed_to_spawn;
+
+    scroll_d.is_identified  = true;
+    scroll_d.is_tried       = true;
+    scroll_d.allow_spawn    = false;
+
+    zuul_d.nr_kills                 = 3;
+    zuul_d.nr_left_allowed_to_spawn = ZUUL_NR_LEFT + 1;
+
+    player_d.name_a     = "TEST PLAYER";
+    player_d.name_the   = "TEST PLAYER";
+
+    init::cleanup_session();
+    init::init_session();
+
+    CHECK_EQUAL(false,  scroll_d.is_identified);
+    CHECK_EQUAL(false,  scroll_d.is_tried);
+    CHECK_EQUAL(true,   scroll_d.allow_spawn);
+
+    CHECK_EQUAL(0,              zuul_d.nr_kills);
+    CHECK_EQUAL(ZUUL_NR_LEFT,   zuul_d.nr_left_allowed_to_spawn);
+
+    CHECK_EQUAL("Player", player_d.name_a);
+    CHECK_EQUAL("Player", player_d.name_the);
+
+    //The rest of the data is kept
+    CHECK_EQUAL(int(Item_type::scroll),     int(scroll_d.type));
+    CHECK_EQUAL(int(Spell_id::teleport),    int(scroll_d.spell_cast_from_scroll));
+    CHECK_EQUAL(int(Actor_id::zuul),        int(zuul_d.id));
+}
+
+TEST_FIXTURE(Basic_fixture, map_templates)
+{
+    const Map_templ& templ = map_templ_handling::templ(Map_templ_id::trapez_level);
+
+    CHECK(templ.dims() == P(MAP_W, MAP_H));
+
+    int nr_trapez = 0;
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            const Map_templ_cell& cell = templ.cell(P(x, y));
+
+            if (cell.item_id == Item_id::trapez)
+            {
+                CHECK_EQUAL('o', cell.ch);
+                CHECK(cell.feature_id == Feature_id::floor);
+                ++nr_trapez;
+            }
+        }
+    }
+
+    CHECK_EQUAL(1, nr_trapez);
+
+    //Corners are walls
+    CHECK(templ.cell(P(0, 0)).feature_id                 == Feature_id::wall);
+    CHECK(templ.cell(P(MAP_W - 1, MAP_H - 1)).feature_id == Feature_id::wall);
+}
+
+TEST_FIXTURE(Basic_fixture, cell_planes)
+{
+    const P p(10, 5);
+
+    map::put(new Floor(p));
+
+    //The cell view refers to the planes
+    CHECK(map::cells[p.x][p.y].rigid_id == Feature_id::floor);
+    CHECK(map::planes.rigid_id[p.x][p.y] == Feature_id::floor);
+    CHECK(map::cells[p.x][p.y].pos == p);
+
+    map::cells[p.x][p.y].is_lit = true;
+    CHECK(map::planes.is_lit[p.x][p.y]);
+
+    map::planes.is_dark[p.x][p.y] = true;
+    CHECK(map::cells[p.x][p.y].is_dark);
+
+    //Replacing the rigid updates the id
+    map::put(new Wall(p));
+    CHECK(map::cells[p.x][p.y].rigid->id() == Feature_id::wall);
+    CHECK(map::cells[p.x][p.y].rigid_id == Feature_id::wall);
+
+    map::reset_map();
+
+    CHECK(!map::planes.is_lit[p.x][p.y]);
+    CHECK(!map::planes.is_dark[p.x][p.y]);
+}
+
+TEST_FIXTURE(Basic_fixture, active_rigids)
+{
+    const P p(10, 5);
+
+    map::put(new Floor(p));
+
+    CHECK(!map::cells[p.x][p.y].rigid->is_active());
+    CHECK(!map::is_rigid_active(p));
+
+    //Corrupting the color activates the rigid
+    map::cells[p.x][p.y].rigid->corrupt_color();
+
+    CHECK(map::cells[p.x][p.y].rigid->is_active());
+    CHECK(map::is_rigid_active(p));
+    CHECK(map::active_rigids().size() == 1);
+
+    //Activating again does not register the position twice
+    map::activate_rigid(p);
+    CHECK(map::active_rigids().size() == 1);
+
+    map::remove_inactive_rigids();
+    CHECK(map::is_rigid_active(p));
+
+    //Becomes inactive when the color corruption wears off
+    for (int i = 0; i < 300; ++i)
+    {
+        map::cells[p.x][p.y].rigid->on_new_turn();
+    }
+
+    CHECK(!map::cells[p.x][p.y].rigid->is_active());
+
+    map::remove_inactive_rigids();
+    CHECK(!map::is_rigid_active(p));
+    CHECK(map::active_rigids().empty());
+
+    //Resetting the map unregisters all rigids
+    map::cells[p.x][p.y].rigid->corrupt_color();
+    CHECK(map::is_rigid_active(p));
+
+    map::reset_map();
+
+    CHECK(!map::is_rigid_active(p));
+    CHECK(map::active_rigids().empty());
+}
+
+TEST_FIXTURE(Basic_fixture, actor_index)
+{
+    const P player_p(1, 1);
+    const P mon_p(10, 5);
+
+    map::invalidate_actor_index();
+
+    CHECK(map::living_actor_at_pos_indexed(player_p) == map::player);
+    CHECK(!map::living_actor_at_pos_indexed(mon_p));
+
+    //Adding actors invalidates the index
+    Actor* const mon = actor_factory::mk(Actor_id::rat, mon_p);
+
+    CHECK(map::living_actor_at_pos_indexed(mon_p) == mon);
+
+    //Setting the position directly requires invalidating
+    map::player->pos = P(2, 1);
+    map::invalidate_actor_index();
+
+    CHECK(!map::living_actor_at_pos_indexed(player_p));
+    CHECK(map::living_actor_at_pos_indexed(P(2, 1)) == map::player);
+
+    //Actors walking invalidates the index
+    map::put(new Floor(P(11, 5)));
+
+    static_cast<Mon*>(mon)->move(Dir::right);
+
+    CHECK(!map::living_actor_at_pos_indexed(mon_p));
+    CHECK(map::living_actor_at_pos_indexed(P(11, 5)) == mon);
+
+    //Dead actors are not indexed (dying invalidates the index)
+    mon->die(true, false, false);
+
+    CHECK(!map::living_actor_at_pos_indexed(P(11, 5)));
+    CHECK(map::actor_at_pos(P(11, 5)) == map::living_actor_at_pos_indexed(P(11, 5)));
+}
+
+TEST_FIXTURE(Basic_fixture, gas_field)
+{
+    const P p(10, 5);
+
+    map::put(new Floor(p));
+
+    CHECK(!gas::is_any_gas());
+    CHECK(!map_parse::cell(cell_check::Blocks_los(), p));
+
+    gas::add(Gas_id::smoke, p, 3);
+
+    CHECK(gas::is_any_gas());
+    CHECK(gas::has_gas(Gas_id::smoke, p));
+    CHECK(!gas::has_gas(Gas_id::smoke, P(11, 5)));
+
+    //Smoke blocks line of sight
+    CHECK(map_parse::cell(cell_check::Blocks_los(), p));
+
+    //Adding gas never shortens the lifetime
+    gas::add(Gas_id::smoke, p, 1);
+    CHECK_EQUAL(3, gas::nr_turns_left(Gas_id::smoke, p));
+
+    gas::add(Gas_id::smoke, p, 5);
+    CHECK_EQUAL(5, gas::nr_turns_left(Gas_id::smoke, p));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        gas::on_new_turn();
+    }
+
+    CHECK_EQUAL(1, gas::nr_turns_left(Gas_id::smoke, p));
+
+    gas::on_new_turn();
+
+    CHECK(!gas::has_gas(Gas_id::smoke, p));
+    CHECK(!gas::is_any_gas());
+    CHECK(!map_parse::cell(cell_check::Blocks_los(), p));
+
+    //Resetting the map removes all gas
+    gas::add(Gas_id::smoke, p, 5);
+
+    map::reset_map();
+
+    CHECK(!gas::has_gas(Gas_id::smoke, p));
+    CHECK(!gas::is_any_gas());
+}
+
+TEST_FIXTURE(Basic_fixture, gas_discards_los_cache)
+{
+    const P p0(10, 5);
+    const P p1(p0.x + 4, p0.y);
+    const P p_smoke(p0.x + 2, p0.y);
+
+    for (int x = p0.x; x <= p1.x; ++x)
+    {
+        map::put(new Floor(P(x, p0.y)));
+    }
+
+    bool blocked[MAP_W][MAP_H];
+    map_parse::run(cell_check::Blocks_los(), blocked);
+
+    Los_cache cache;
+
+    CHECK(!cache.check_cell(p0, p1, blocked).is_blocked_hard);
+
+    //Smoke appearing between the cells discards the stored result
+    gas::add(Gas_id::smoke, p_smoke, 2);
+
+    map_parse::run(cell_check::Blocks_los(), blocked);
+
+    CHECK(cache.check_cell(p0, p1, blocked).is_blocked_hard);
+
+    //...and so does the smoke disappearing
+    gas::on_new_turn();
+
+    CHECK(gas::has_gas(Gas_id::smoke, p_smoke));
+
+    gas::on_new_turn();
+
+    CHECK(!gas::has_gas(Gas_id::smoke, p_smoke));
+
+    map_parse::run(cell_check::Blocks_los(), blocked);
+
+    CHECK(!cache.check_cell(p0, p1, blocked).is_blocked_hard);
+}
+
+TEST_FIXTURE(Basic_fixture, fast_forward)
+{
+    Player& player = *map::player;
+
+    CHECK(!player.is_in_multi_turn_action());
+
+    player.wait_turns_left = 3;
+
+    CHECK(player.is_in_multi_turn_action());
+
+    //Messages end fast-forwarding (and waiting)
+    render::set_fast_forward(true);
+
+    msg_log::add("Something happens.");
+
+    CHECK(!render::is_fast_forwarding());
+    CHECK(!player.is_in_multi_turn_action());
+
+    //Interrupted actions end fast-forwarding
+    player.set_quick_move(Dir::right);
+
+    render::set_fast_forward(true);
+
+    player.interrupt_actions();
+
+    CHECK(!render::is_fast_forwarding());
+    CHECK(!player.is_in_multi_turn_action());
+}
+
+TEST_FIXTURE(Basic_fixture, msg_history)
+{
+    msg_log::init();
+
+    //Repeated messages
+    msg_log::add("Something happens.");
+    msg_log::add("Something happens.");
+
+    msg_log::clear();
+
+    CHECK_EQUAL(1, msg_log::history_size());
+    CHECK_EQUAL(1, int(msg_log::history_line(0).size()));
+
+    std::string str = "";
+
+    msg_log::history_line(0)[0].str_with_repeats(str);
+
+    CHECK_EQUAL("Something happens.(x2)", str);
+
+    //Messages with the same text share the same string
+    const Msg msg_a("Foo", clr_white, 0);
+    const Msg msg_b("Foo", clr_red, 10);
+    const Msg msg_c("Bar", clr_white, 0);
+
+    CHECK(msg_a.is_same_str(msg_b));
+    CHECK(!msg_a.is_same_str(msg_c));
+
+    //The history only keeps the most recent lines (this also adds enough
+    //different strings to remove the unused interned strings)
+    for (int i = 0; i < 3000; ++i)
+    {
+        msg_log::add_line_to_history("Line " + to_str(i));
+    }
+
+    CHECK_EQUAL(300, msg_log::history_size());
+
+    msg_log::history_line(0)[0].str_raw(str);
+
+    CHECK_EQUAL("Line 2700", str);
+
+    msg_log::history_line(299)[0].str_raw(str);
+
+    CHECK_EQUAL("Line 2999", str);
+}
+
 TEST_FIXTURE(Basic_fixture, flood_filling)
 {
     bool b[MAP_W][MAP_H] = {};
@@ -1133,8 +1557,8 @@ TEST_FIXTURE(Basic_fixture, flood_filling)
     CHECK_EQUAL(4, flood[24][12]);
     CHECK_EQUAL(4, flood[24][14]);
     CHECK_EQUAL(5, flood[24][15]);
-    CHECK_EQUAL(0, flood[0][0]);
-    CHECK_EQUAL(0, flood[MAP_W - 1][MAP_H - 1]);
+    CHECK_EQUAL(flood_fill::unreached, flood[0][0]);
+    CHECK_EQUAL(flood_fill::unreached, flood[MAP_W - 1][MAP_H - 1]);
 }
 
 TEST_FIXTURE(Basic_fixture, path_finding)
@@ -1211,6 +1635,74 @@ TEST_FIXTURE(Basic_fixture, path_finding)
     CHECK_EQUAL(10, int(path.size()));
 }
 
+TEST_FIXTURE(Basic_fixture, a_star_path_finding)
+{
+    std::vector<P> path;
+    bool b[MAP_W][MAP_H] = {};
+
+    a_star::run(P(20, 10), P(25, 10), b, path);
+
+    CHECK_EQUAL(5, int(path.size()));
+    CHECK(path.front() == P(25, 10));
+    CHECK(path.back() != P(20, 10));
+
+    a_star::run(P(20, 10), P(5, 3), b, path);
+
+    CHECK_EQUAL(15, int(path.size()));
+    CHECK(path.front() == P(5, 3));
+
+    b[10][5] = true;
+
+    a_star::run(P(7, 5), P(20, 5), b, path);
+
+    CHECK_EQUAL(13, int(path.size()));
+    CHECK(find(begin(path), end(path), P(10, 5)) == end(path));
+
+    a_star::run(P(40, 10), P(43, 15), b, path, false);
+
+    CHECK_EQUAL(8, int(path.size()));
+
+    //Target blocked
+    b[30][10] = true;
+
+    CHECK(a_star::run(P(20, 10), P(30, 10), b, path));
+
+    CHECK(path.empty());
+
+    //Too few expansions allowed
+    CHECK(!a_star::run(P(20, 10), P(25, 10), b, path, true, 2));
+
+    CHECK(path.empty());
+
+    //Expensive cells are avoided if there is a cheaper way around
+    int cost[MAP_W][MAP_H];
+
+    std::fill_n(*cost, NR_MAP_CELLS, 1);
+
+    for (int y = 8; y <= 12; ++y)
+    {
+        cost[50][y] = 20;
+    }
+
+    a_star::run(P(45, 10), P(55, 10), cost, path);
+
+    CHECK(!path.empty());
+
+    for (const P& p : path)
+    {
+        CHECK(cost[p.x][p.y] == 1);
+    }
+
+    //Partial path towards the target when too few expansions are allowed
+    std::fill_n(*cost, NR_MAP_CELLS, 1);
+
+    CHECK(!a_star::run(P(20, 10), P(30, 10), cost, path, true, 2, true));
+
+    CHECK(!path.empty());
+    CHECK(is_pos_adj(P(20, 10), path.back(), false));
+    CHECK(path.front().x > 20);
+}
+
 TEST_FIXTURE(Basic_fixture, map_parse_expand_one)
 {
     bool in[MAP_W][MAP_H] = {};
@@ -1535,6 +2027,155 @@ TEST_FIXTURE(Basic_fixture, map_parse_cells_within_dist_of_others)
     CHECK_EQUAL(false, out[23][10]);
     CHECK_EQUAL(true,  out[24][10]);
     CHECK_EQUAL(false, out[25][10]);
+
+    //At the map edge, the interval is the same as elsewhere (both ends are
+    //inclusive, and cells closer than the minimum distance are not included)
+    std::fill_n(*in, NR_MAP_CELLS, false);
+
+    in[0][10] = true;
+
+    map_parse::cells_within_dist_of_others(in, out, Range(2, 3));
+    CHECK_EQUAL(false, out[0][10]);
+    CHECK_EQUAL(false, out[1][10]);
+    CHECK_EQUAL(false, out[0][11]);
+    CHECK_EQUAL(false, out[1][ 9]);
+    CHECK_EQUAL(true,  out[2][10]);
+    CHECK_EQUAL(true,  out[0][12]);
+    CHECK_EQUAL(true,  out[0][ 7]);
+    CHECK_EQUAL(true,  out[3][13]);
+    CHECK_EQUAL(false, out[4][10]);
+    CHECK_EQUAL(false, out[0][14]);
+
+    //Map corner
+    std::fill_n(*in, NR_MAP_CELLS, false);
+
+    in[MAP_W - 1][MAP_H - 1] = true;
+
+    map_parse::cells_within_dist_of_others(in, out, Range(1, 1));
+    CHECK_EQUAL(false, out[MAP_W - 1][MAP_H - 1]);
+    CHECK_EQUAL(true,  out[MAP_W - 2][MAP_H - 2]);
+    CHECK_EQUAL(true,  out[MAP_W - 1][MAP_H - 2]);
+    CHECK_EQUAL(false, out[MAP_W - 3][MAP_H - 1]);
+}
+
+TEST_FIXTURE(Basic_fixture, bit_grid_matches_brute_force)
+{
+    bool in[MAP_W][MAP_H] = {};
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            in[x][y] = rnd::one_in(12);
+        }
+    }
+
+    //Include cells along the map edges
+    in[0][0]                    = true;
+    in[MAP_W - 1][MAP_H - 1]    = true;
+    in[63][5]                   = true;
+    in[64][6]                   = true;
+
+    const Bit_grid grid(in);
+
+    const int   DIST = 2;
+    const Range band(2, 4);
+
+    bool dilated[MAP_W][MAP_H];
+    bool eroded[MAP_W][MAP_H];
+    bool in_band[MAP_W][MAP_H];
+
+    grid.dilated(DIST).to_array(dilated);
+    grid.eroded(DIST).to_array(eroded);
+    grid.dist_band(band).to_array(in_band);
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            bool is_dilated = false;
+            bool is_eroded  = true;
+            bool is_in_band = false;
+
+            for (int x_other = 0; x_other < MAP_W; ++x_other)
+            {
+                for (int y_other = 0; y_other < MAP_H; ++y_other)
+                {
+                    const int D = king_dist(P(x, y), P(x_other, y_other));
+
+                    if (in[x_other][y_other])
+                    {
+                        is_dilated = is_dilated || D <= DIST;
+                        is_in_band = is_in_band || is_val_in_range(D, band);
+                    }
+                    else if (D <= DIST)
+                    {
+                        is_eroded = false;
+                    }
+                }
+            }
+
+            CHECK_EQUAL(in[x][y],   grid.at(P(x, y)));
+            CHECK_EQUAL(is_dilated, dilated[x][y]);
+            CHECK_EQUAL(is_eroded,  eroded[x][y]);
+            CHECK_EQUAL(is_in_band, in_band[x][y]);
+        }
+    }
+}
+
+TEST_FIXTURE(Basic_fixture, dist_fields)
+{
+    bool sources[MAP_W][MAP_H] = {};
+
+    sources[10][10] = true;
+    sources[40][5]  = true;
+
+    int dist[MAP_W][MAP_H];
+
+    dist_field::chebyshev(sources, dist);
+
+    CHECK_EQUAL(0,  dist[10][10]);
+    CHECK_EQUAL(1,  dist[11][11]);
+    CHECK_EQUAL(5,  dist[15][7]);
+    CHECK_EQUAL(2,  dist[42][3]);
+    CHECK_EQUAL(39, dist[79][0]);
+
+    //Cells sorted by distance from a single position
+    dist_field::chebyshev(P(20, 10), dist);
+
+    bool include[MAP_W][MAP_H];
+    std::fill_n(*include, NR_MAP_CELLS, true);
+
+    std::vector<P> sorted;
+
+    dist_field::sorted_cells(dist, include, sorted, 2);
+
+    CHECK_EQUAL(25, int(sorted.size()));
+    CHECK(sorted.front() == P(20, 10));
+
+    for (size_t i = 1; i < sorted.size(); ++i)
+    {
+        const P& p0 = sorted[i - 1];
+        const P& p1 = sorted[i];
+
+        CHECK(dist[p0.x][p0.y] <= dist[p1.x][p1.y]);
+    }
+
+    //Only visiting the cells near the position gives the same order
+    std::vector<P> sorted_near;
+
+    dist_field::sorted_cells_near(P(20, 10), include, sorted_near, 2);
+
+    CHECK(sorted_near == sorted);
+
+    //Next to the map corner
+    dist_field::chebyshev(P(1, 0), dist);
+
+    dist_field::sorted_cells(dist, include, sorted, 3);
+    dist_field::sorted_cells_near(P(1, 0), include, sorted_near, 3);
+
+    CHECK_EQUAL(20, int(sorted_near.size()));
+    CHECK(sorted_near == sorted);
 }
 
 //-----------------------------------------------------------------------------
@@ -1649,6 +2290,9 @@ TEST_FIXTURE(Basic_fixture, mapgen_std)
         while (!map_ok)
         {
             map_ok = mapgen::mk_std_lvl();
+
+            //Discarded maps should always tell why
+            CHECK(map_ok == (mapgen::invalid_reason == Map_invalid_reason::none));
         }
 
         map::player->teleport();
@@ -1668,6 +2312,113 @@ TEST_FIXTURE(Basic_fixture, mapgen_std)
     }
 }
 
+TEST(run_log)
+{
+    const std::string file_path = "data/test_run_log";
+
+    std::remove(file_path.c_str());
+    std::remove((file_path + "_top").c_str());
+
+    CHECK_EQUAL(0, int(run_log::nr_records(file_path)));
+
+    const int scores[] = {10, 30, 20, 30, 5};
+
+    for (int i = 0; i < 5; ++i)
+    {
+        Run_record record;
+
+        run_log::set_str(record.name, "Run " + to_str(i));
+
+        record.score    = scores[i];
+        record.dlvl     = i;
+
+        //The best scoring run is a bot run, which should not be in the index
+        record.is_bot   = i == 1;
+
+        run_log::append(record, file_path);
+    }
+
+    CHECK_EQUAL(5, int(run_log::nr_records(file_path)));
+
+    Run_record record;
+
+    CHECK(run_log::read_record(2, record, file_path));
+    CHECK_EQUAL("Run 2", std::string(record.name));
+    CHECK_EQUAL(20, record.score);
+    CHECK_EQUAL(2, record.dlvl);
+
+    CHECK(!run_log::read_record(5, record, file_path));
+
+    std::vector<Run_record> top;
+
+    run_log::read_top(top, file_path);
+
+    CHECK_EQUAL(4, int(top.size()));
+    CHECK_EQUAL("Run 3", std::string(top[0].name));
+    CHECK_EQUAL("Run 2", std::string(top[1].name));
+    CHECK_EQUAL("Run 0", std::string(top[2].name));
+    CHECK_EQUAL("Run 4", std::string(top[3].name));
+
+    //The index is rebuilt from the log if it is missing
+    std::remove((file_path + "_top").c_str());
+
+    run_log::read_top(top, file_path);
+
+    CHECK_EQUAL(4, int(top.size()));
+    CHECK_EQUAL("Run 3", std::string(top[0].name));
+
+    //Too long strings are truncated
+    run_log::set_str(record.name, std::string(run_record_str_len * 2, 'x'));
+
+    CHECK_EQUAL(run_record_str_len - 1, std::string(record.name).size());
+
+    std::remove(file_path.c_str());
+    std::remove((file_path + "_top").c_str());
+}
+
+TEST_FIXTURE(Basic_fixture, mapgen_phase_stats)
+{
+    mapgen::reset_phase_stats();
+
+    CHECK_EQUAL(0, mapgen::phase_stats(Mapgen_phase::init).nr_runs);
+
+    int nr_attempts = 0;
+
+    bool map_ok = false;
+
+    while (!map_ok)
+    {
+        map_ok = mapgen::mk_std_lvl();
+
+        ++nr_attempts;
+    }
+
+    //Every attempt runs the first phase, and the successful attempt runs the
+    //later phases
+    CHECK_EQUAL(nr_attempts, mapgen::phase_stats(Mapgen_phase::init).nr_runs);
+
+    CHECK(mapgen::phase_stats(Mapgen_phase::connect_rooms).nr_runs >= 1);
+    CHECK(mapgen::phase_stats(Mapgen_phase::place_stairs).nr_runs >= 1);
+
+    //The number of rejections in all phases should equal the number of discarded
+    //attempts
+    int nr_rejections_tot = 0;
+
+    for (size_t i = 0; i < size_t(Mapgen_phase::END); ++i)
+    {
+        const Mapgen_phase_stats& stats = mapgen::phase_stats(Mapgen_phase(i));
+
+        CHECK(stats.nr_rejections <= stats.nr_runs);
+        CHECK(stats.ms_tot >= 0.0);
+
+        nr_rejections_tot += stats.nr_rejections;
+    }
+
+    CHECK_EQUAL(nr_attempts - 1, nr_rejections_tot);
+
+    CHECK(!mapgen::phase_name(Mapgen_phase::connect_rooms).empty());
+}
+
 #ifdef _WIN32
 #undef main
 #endif
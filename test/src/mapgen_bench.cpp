@@ -0,0 +1,355 @@
+//Map generation benchmark - generates levels of every map type and depth for a
+//range of random seeds, without rendering, and reports how many attempts the
+//levels needed, why attempts were discarded, and the time spent (in total, and
+//in each phase of standard level generation).
+//
+//Usage:
+//  mapgen_bench [NR_SEEDS] [FIRST_SEED] [MAX_NR_ATTEMPTS]
+//
+//Each level is generated with the random generator seeded by the seed number,
+//so any level can be reproduced by running the benchmark with FIRST_SEED set
+//to the reported seed, and NR_SEEDS set to 1.
+//
+//Each seed starts a new game session, since map generation changes session state
+//(e.g. the number of unique monsters and items left to spawn). The levels of one
+//seed are built in order of depth, as in a game.
+//
+//NOTE: Map generation works on the global map state, so all levels are built
+//on one thread. To use more cores, run several benchmarks with different seed
+//ranges.
+
+#include "init.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+#include <SDL.h>
+
+#include "map.hpp"
+#include "map_travel.hpp"
+#include "mapgen.hpp"
+#include "actor_player.hpp"
+
+namespace
+{
+
+struct Bench_lvl
+{
+    Map_type    type;
+    std::string name;
+    int         dlvl;
+};
+
+struct Lvl_stats
+{
+    Lvl_stats() :
+        nr_lvls         (0),
+        nr_attempts_tot (0),
+        nr_attempts_min (INT32_MAX),
+        nr_attempts_max (0),
+        ms_tot          (0.0) {}
+
+    int     nr_lvls;
+    int     nr_attempts_tot;
+    int     nr_attempts_min;
+    int     nr_attempts_max;
+    double  ms_tot;
+};
+
+struct Failed_seed
+{
+    uint32_t            seed;
+    const Bench_lvl*    lvl;
+};
+
+//Upper limits (inclusive) of the buckets in the attempt count histogram
+const int attempt_buckets[] = {1, 2, 4, 8, 16, 32, 64, INT32_MAX};
+
+const size_t nr_attempt_buckets = sizeof(attempt_buckets) / sizeof(attempt_buckets[0]);
+
+//Number of example seeds to print for each reason to discard a map
+const size_t nr_seeds_per_reason = 5;
+
+std::string invalid_reason_str(const Map_invalid_reason reason)
+{
+    switch (reason)
+    {
+    case Map_invalid_reason::none:                  return "none";
+    case Map_invalid_reason::no_connectable_rooms:  return "no_connectable_rooms";
+    case Map_invalid_reason::connect_rooms:         return "connect_rooms";
+    case Map_invalid_reason::inner_room_entrance:   return "inner_room_entrance";
+    case Map_invalid_reason::bridges:               return "bridges";
+    case Map_invalid_reason::player_pos:            return "player_pos";
+    case Map_invalid_reason::place_stairs:          return "place_stairs";
+    case Map_invalid_reason::END:                   break;
+    }
+
+    return "";
+}
+
+void mk_bench_lvls(std::vector<Bench_lvl>& out)
+{
+    //Same depths as in map_travel::init()
+    out.push_back({Map_type::intro, "intro", 0});
+
+    for (int dlvl = 1; dlvl <= DLVL_LAST; ++dlvl)
+    {
+        out.push_back({Map_type::std, "std", dlvl});
+    }
+
+    out.push_back({Map_type::rats_in_the_walls, "rats_in_the_walls", DLVL_FIRST_LATE_GAME - 1});
+    out.push_back({Map_type::egypt,             "egypt",             DLVL_FIRST_LATE_GAME});
+    out.push_back({Map_type::leng,              "leng",              DLVL_FIRST_LATE_GAME});
+    out.push_back({Map_type::boss,              "boss",              DLVL_LAST + 1});
+    out.push_back({Map_type::trapez,            "trapez",            DLVL_LAST + 2});
+}
+
+bool mk_lvl_attempt(const Map_type type)
+{
+    switch (type)
+    {
+    case Map_type::intro:               return mapgen::mk_intro_lvl();
+    case Map_type::std:                 return mapgen::mk_std_lvl();
+    case Map_type::egypt:               return mapgen::mk_egypt_lvl();
+    case Map_type::leng:                return mapgen::mk_leng_lvl();
+    case Map_type::rats_in_the_walls:   return mapgen::mk_rats_in_the_walls_lvl();
+    case Map_type::trapez:              return mapgen::mk_trapez_lvl();
+    case Map_type::boss:                return mapgen::mk_boss_lvl();
+    }
+
+    return false;
+}
+
+int arg_or_default(const int argc, char* argv[], const int IDX, const int DEFAULT)
+{
+    return argc > IDX ? atoi(argv[IDX]) : DEFAULT;
+}
+
+} //namespace
+
+#ifdef _WIN32
+#undef main
+#endif
+int main(int argc, char* argv[])
+{
+    const int       NR_SEEDS        = std::max(1, arg_or_default(argc, argv, 1, 100));
+    const uint32_t  FIRST_SEED      = uint32_t(arg_or_default(argc, argv, 2, 1));
+    const int       MAX_NR_ATTEMPTS = std::max(1, arg_or_default(argc, argv, 3, 100));
+
+    init::init_game();
+
+    std::vector<Bench_lvl> lvls;
+    mk_bench_lvls(lvls);
+
+    std::vector<Lvl_stats> lvl_stats(lvls.size());
+
+    int nr_in_attempt_bucket[nr_attempt_buckets] = {};
+
+    int nr_invalid_for_reason[size_t(Map_invalid_reason::END)] = {};
+
+    std::vector<Failed_seed> seeds_for_reason[size_t(Map_invalid_reason::END)];
+
+    //Levels which could not be built within the maximum number of attempts
+    std::vector<Failed_seed> gave_up_seeds;
+
+    mapgen::reset_phase_stats();
+
+    const auto bench_start_time = std::chrono::steady_clock::now();
+
+    for (int seed_idx = 0; seed_idx < NR_SEEDS; ++seed_idx)
+    {
+        const uint32_t SEED = FIRST_SEED + uint32_t(seed_idx);
+
+        rnd::seed(SEED);
+
+        init::init_session();
+
+        for (size_t lvl_idx = 0; lvl_idx < lvls.size(); ++lvl_idx)
+        {
+            const Bench_lvl& lvl = lvls[lvl_idx];
+
+            rnd::seed(SEED);
+
+            map::dlvl = lvl.dlvl;
+
+            const auto start_time = std::chrono::steady_clock::now();
+
+            int nr_attempts = 0;
+
+            bool is_ok = false;
+
+            while (!is_ok && nr_attempts < MAX_NR_ATTEMPTS)
+            {
+                ++nr_attempts;
+
+                is_ok = mk_lvl_attempt(lvl.type);
+
+                if (!is_ok)
+                {
+                    const size_t REASON_IDX = size_t(mapgen::invalid_reason);
+
+                    ++nr_invalid_for_reason[REASON_IDX];
+
+                    auto& seeds = seeds_for_reason[REASON_IDX];
+
+                    if (seeds.size() < nr_seeds_per_reason)
+                    {
+                        seeds.push_back({SEED, &lvl});
+                    }
+                }
+            }
+
+            const auto diff_time = std::chrono::steady_clock::now() - start_time;
+
+            if (!is_ok)
+            {
+                gave_up_seeds.push_back({SEED, &lvl});
+            }
+
+            Lvl_stats& stats = lvl_stats[lvl_idx];
+
+            ++stats.nr_lvls;
+
+            stats.nr_attempts_tot += nr_attempts;
+            stats.nr_attempts_min = std::min(stats.nr_attempts_min, nr_attempts);
+            stats.nr_attempts_max = std::max(stats.nr_attempts_max, nr_attempts);
+            stats.ms_tot          += std::chrono::duration<double, std::milli>(diff_time).count();
+
+            for (size_t i = 0; i < nr_attempt_buckets; ++i)
+            {
+                if (nr_attempts <= attempt_buckets[i])
+                {
+                    ++nr_in_attempt_bucket[i];
+                    break;
+                }
+            }
+        }
+
+        init::cleanup_session();
+    }
+
+    const auto bench_diff_time = std::chrono::steady_clock::now() - bench_start_time;
+
+    //------------------------------------------------------------------- REPORT
+    std::cout << "Map generation benchmark, seeds " << FIRST_SEED << "-"
+              << (FIRST_SEED + uint32_t(NR_SEEDS) - 1) << std::endl
+              << std::endl;
+
+    std::cout << std::left
+              << std::setw(20) << "Map type"
+              << std::right
+              << std::setw(6)  << "Dlvl"
+              << std::setw(10) << "Attempts"
+              << std::setw(8)  << "(min"
+              << std::setw(8)  << "avg"
+              << std::setw(8)  << "max)"
+              << std::setw(14) << "ms/level" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (size_t lvl_idx = 0; lvl_idx < lvls.size(); ++lvl_idx)
+    {
+        const Bench_lvl&    lvl     = lvls[lvl_idx];
+        const Lvl_stats&    stats   = lvl_stats[lvl_idx];
+
+        std::cout << std::left
+                  << std::setw(20) << lvl.name
+                  << std::right
+                  << std::setw(6)  << lvl.dlvl
+                  << std::setw(10) << stats.nr_attempts_tot
+                  << std::setw(8)  << stats.nr_attempts_min
+                  << std::setw(8)  << double(stats.nr_attempts_tot) / stats.nr_lvls
+                  << std::setw(8)  << stats.nr_attempts_max
+                  << std::setw(14) << stats.ms_tot / stats.nr_lvls << std::endl;
+    }
+
+    std::cout << std::endl << "Attempts needed per level:" << std::endl;
+
+    for (size_t i = 0; i < nr_attempt_buckets; ++i)
+    {
+        const int BUCKET_MIN = i == 0 ? 1 : (attempt_buckets[i - 1] + 1);
+        const int BUCKET_MAX = attempt_buckets[i];
+
+        const std::string range_str =
+            BUCKET_MAX == INT32_MAX     ? (to_str(BUCKET_MIN) + "+") :
+            BUCKET_MIN == BUCKET_MAX    ? to_str(BUCKET_MIN) :
+            (to_str(BUCKET_MIN) + "-" + to_str(BUCKET_MAX));
+
+        std::cout << "  " << std::left << std::setw(10) << range_str
+                  << std::right << std::setw(10) << nr_in_attempt_bucket[i] << std::endl;
+    }
+
+    std::cout << std::endl << "Discarded attempts per reason:" << std::endl;
+
+    for (size_t i = 1; i < size_t(Map_invalid_reason::END); ++i)
+    {
+        std::cout << "  " << std::left << std::setw(22)
+                  << invalid_reason_str(Map_invalid_reason(i))
+                  << std::right << std::setw(10) << nr_invalid_for_reason[i];
+
+        for (const Failed_seed& failed : seeds_for_reason[i])
+        {
+            std::cout << "  (seed " << failed.seed << ", " << failed.lvl->name
+                      << " dlvl " << failed.lvl->dlvl << ")";
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl << "Standard level phases:" << std::endl;
+
+    std::cout << "  "
+              << std::left
+              << std::setw(18) << "Phase"
+              << std::right
+              << std::setw(10) << "Runs"
+              << std::setw(12) << "Rejections"
+              << std::setw(12) << "ms/run"
+              << std::setw(12) << "ms total" << std::endl;
+
+    for (size_t i = 0; i < size_t(Mapgen_phase::END); ++i)
+    {
+        const Mapgen_phase          phase = Mapgen_phase(i);
+        const Mapgen_phase_stats&   stats = mapgen::phase_stats(phase);
+
+        if (stats.nr_runs == 0)
+        {
+            continue;
+        }
+
+        std::cout << "  "
+                  << std::left
+                  << std::setw(18) << mapgen::phase_name(phase)
+                  << std::right
+                  << std::setw(10) << stats.nr_runs
+                  << std::setw(12) << stats.nr_rejections
+                  << std::setw(12) << stats.ms_tot / stats.nr_runs
+                  << std::setw(12) << stats.ms_tot << std::endl;
+    }
+
+    if (!gave_up_seeds.empty())
+    {
+        std::cout << std::endl << "Not built within " << MAX_NR_ATTEMPTS
+                  << " attempts:" << std::endl;
+
+        for (const Failed_seed& failed : gave_up_seeds)
+        {
+            std::cout << "  seed " << failed.seed << ", " << failed.lvl->name
+                      << " dlvl " << failed.lvl->dlvl << std::endl;
+        }
+    }
+
+    std::cout << std::endl << "Total time: "
+              << std::chrono::duration<double>(bench_diff_time).count() << " s"
+              << std::endl;
+
+    init::cleanup_game();
+
+    return gave_up_seeds.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
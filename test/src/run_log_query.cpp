@@ -0,0 +1,220 @@
+//Run log query tool - reads the run log written at the end of each game (and
+//after each completed bot run), and reports statistics over the runs: wins,
+//depth reached, causes of death, and the best scores.
+//
+//Usage:
+//  run_log_query [all|human|bot] [LOG_FILE]
+//
+//The log file defaults to the run log of the game (data/run_log).
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+#include <SDL.h>
+
+#include "run_log.hpp"
+
+namespace
+{
+
+enum class Run_filter
+{
+    all,
+    human,
+    bot
+};
+
+//Number of best scores to print
+const size_t nr_top_to_show = 10;
+
+bool is_run_included(const Run_record& record, const Run_filter filter)
+{
+    switch (filter)
+    {
+    case Run_filter::all:   return true;
+    case Run_filter::human: return !record.is_bot;
+    case Run_filter::bot:   return record.is_bot;
+    }
+
+    return false;
+}
+
+std::string death_cause_str(const Run_record& record)
+{
+    if (record.is_win)
+    {
+        return "(won the game)";
+    }
+
+    if (record.death_cause[0] == 0)
+    {
+        //Completed bot runs, and runs imported from the old highscore file
+        return record.is_bot ? "(bot run completed)" : "(unknown)";
+    }
+
+    std::string str = record.death_cause;
+
+    if (record.killer_name[0] != 0)
+    {
+        str += " - " + std::string(record.killer_name);
+    }
+
+    return str;
+}
+
+double percent(const int N, const int TOT)
+{
+    return TOT == 0 ? 0.0 : ((100.0 * N) / TOT);
+}
+
+//Prints the entries sorted by count, highest first
+void print_counts(const std::map<std::string, int>& counts, const int TOT)
+{
+    std::vector<std::pair<std::string, int>> sorted(counts.begin(), counts.end());
+
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const std::pair<std::string, int>& e0,
+                        const std::pair<std::string, int>& e1)
+    {
+        return e0.second > e1.second;
+    });
+
+    for (const auto& e : sorted)
+    {
+        std::cout << "  "
+                  << std::right << std::setw(8) << e.second
+                  << std::setw(8) << percent(e.second, TOT) << "%  "
+                  << std::left << e.first << std::endl;
+    }
+}
+
+} //namespace
+
+#ifdef _WIN32
+#undef main
+#endif
+int main(int argc, char* argv[])
+{
+    Run_filter filter = Run_filter::all;
+
+    if (argc > 1)
+    {
+        const std::string filter_str = argv[1];
+
+        if (filter_str == "human")
+        {
+            filter = Run_filter::human;
+        }
+        else if (filter_str == "bot")
+        {
+            filter = Run_filter::bot;
+        }
+        else if (filter_str != "all")
+        {
+            std::cout << "Usage: run_log_query [all|human|bot] [LOG_FILE]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    const std::string file_path = argc > 2 ? argv[2] : run_log::default_file_path;
+
+    std::vector<Run_record> records;
+    run_log::read_all(records, file_path);
+
+    int nr_runs     = 0;
+    int nr_wins     = 0;
+    int max_dlvl    = 0;
+
+    int64_t nr_turns_tot    = 0;
+    int64_t nr_kills_tot    = 0;
+    int64_t dlvl_tot        = 0;
+
+    std::map<int, int>          nr_runs_for_dlvl;
+    std::map<std::string, int>  nr_runs_for_death_cause;
+
+    for (const Run_record& record : records)
+    {
+        if (!is_run_included(record, filter))
+        {
+            continue;
+        }
+
+        ++nr_runs;
+
+        if (record.is_win)
+        {
+            ++nr_wins;
+        }
+
+        max_dlvl = std::max(max_dlvl, int(record.dlvl));
+
+        nr_turns_tot    += record.nr_turns;
+        nr_kills_tot    += record.nr_kills;
+        dlvl_tot        += record.dlvl;
+
+        ++nr_runs_for_dlvl[record.dlvl];
+        ++nr_runs_for_death_cause[death_cause_str(record)];
+    }
+
+    //------------------------------------------------------------------- REPORT
+    std::cout << "Run log " << file_path << ": " << records.size() << " runs, "
+              << nr_runs << " included" << std::endl;
+
+    if (nr_runs == 0)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "  Wins:             " << nr_wins
+              << " (" << percent(nr_wins, nr_runs) << "%)" << std::endl
+              << "  Average depth:    " << double(dlvl_tot) / nr_runs << std::endl
+              << "  Average turns:    " << double(nr_turns_tot) / nr_runs << std::endl
+              << "  Average kills:    " << double(nr_kills_tot) / nr_runs << std::endl;
+
+    std::cout << std::endl << "Depth reached:" << std::endl;
+
+    for (int dlvl = 0; dlvl <= max_dlvl; ++dlvl)
+    {
+        const auto it = nr_runs_for_dlvl.find(dlvl);
+
+        const int N = it == nr_runs_for_dlvl.end() ? 0 : it->second;
+
+        std::cout << "  " << std::right << std::setw(4) << dlvl
+                  << std::setw(10) << N
+                  << std::setw(8) << percent(N, nr_runs) << "%" << std::endl;
+    }
+
+    std::cout << std::endl << "Causes of death:" << std::endl;
+
+    print_counts(nr_runs_for_death_cause, nr_runs);
+
+    //The index only contains non-bot runs
+    if (filter != Run_filter::bot)
+    {
+        std::vector<Run_record> top;
+        run_log::read_top(top, file_path);
+
+        std::cout << std::endl << "Best scores:" << std::endl;
+
+        for (size_t i = 0; i < top.size() && i < nr_top_to_show; ++i)
+        {
+            const Run_record& record = top[i];
+
+            std::cout << "  " << std::right << std::setw(8) << record.score << "  "
+                      << std::left << std::setw(18) << record.date_and_time
+                      << std::setw(16) << record.name
+                      << "depth " << record.dlvl
+                      << (record.is_win ? ", won" : "") << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}